@@ -21,6 +21,7 @@
 
 #include "conf-file-processor.hpp"
 #include "adjacent.hpp"
+#include "update/prefix-journal.hpp"
 #include "update/prefix-update-processor.hpp"
 #include "utility/name-helper.hpp"
 
@@ -198,6 +199,9 @@ ConfFileProcessor::processSection(const std::string& sectionName, const ConfigSe
   else if (sectionName == "fib") {
     ret = processConfSectionFib(section);
   }
+  else if (sectionName == "routing") {
+    ret = processConfSectionRouting(section);
+  }
   else if (sectionName == "advertising") {
     ret = processConfSectionAdvertising(section);
   }
@@ -316,6 +320,43 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // max-concurrent-lsa-fetches
+  ConfigurationVariable<uint32_t> maxLsaFetches("max-concurrent-lsa-fetches",
+                                                std::bind(&ConfParameter::setMaxConcurrentLsaFetches,
+                                                &m_confParam, _1));
+  maxLsaFetches.setMinAndMaxValue(MAX_CONCURRENT_LSA_FETCHES_MIN, MAX_CONCURRENT_LSA_FETCHES_MAX);
+  maxLsaFetches.setOptional(MAX_CONCURRENT_LSA_FETCHES_DEFAULT);
+
+  if (!maxLsaFetches.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // name-lsa-build-interval
+  ConfigurationVariable<uint32_t> nameLsaBuildInterval("name-lsa-build-interval",
+                                                       std::bind(&ConfParameter::setNameLsaBuildInterval,
+                                                       &m_confParam, _1));
+  nameLsaBuildInterval.setMinAndMaxValue(NAME_LSA_BUILD_INTERVAL_MIN, NAME_LSA_BUILD_INTERVAL_MAX);
+  nameLsaBuildInterval.setOptional(NAME_LSA_BUILD_INTERVAL_DEFAULT);
+
+  if (!nameLsaBuildInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // name-lsa-deltas
+  std::string nameLsaDeltas = section.get<std::string>("name-lsa-deltas", "off");
+
+  if (boost::iequals(nameLsaDeltas, "off")) {
+    m_confParam.setNameLsaDeltasEnabled(false);
+  }
+  else if (boost::iequals(nameLsaDeltas, "on")) {
+    m_confParam.setNameLsaDeltasEnabled(true);
+  }
+  else {
+    std::cerr << "Invalid setting for name-lsa-deltas. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
   // sync-interest-lifetime
   uint32_t syncInterestLifetime = section.get<uint32_t>("sync-interest-lifetime",
                                                         SYNC_INTEREST_LIFETIME_DEFAULT);
@@ -598,6 +639,94 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // routing-calc-initial-wait
+  ConfigurationVariable<uint32_t> routingCalcInitialWait("routing-calc-initial-wait",
+                                                         std::bind(&ConfParameter::setRoutingCalcInitialWait,
+                                                         &m_confParam, _1));
+  routingCalcInitialWait.setMinAndMaxValue(ROUTING_CALC_INITIAL_WAIT_MIN,
+                                           ROUTING_CALC_INITIAL_WAIT_MAX);
+  routingCalcInitialWait.setOptional(ROUTING_CALC_INITIAL_WAIT_DEFAULT);
+
+  if (!routingCalcInitialWait.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-increment
+  ConfigurationVariable<uint32_t> routingCalcIncrement("routing-calc-increment",
+                                                       std::bind(&ConfParameter::setRoutingCalcIncrement,
+                                                       &m_confParam, _1));
+  routingCalcIncrement.setMinAndMaxValue(ROUTING_CALC_INCREMENT_MIN, ROUTING_CALC_INCREMENT_MAX);
+  routingCalcIncrement.setOptional(ROUTING_CALC_INCREMENT_DEFAULT);
+
+  if (!routingCalcIncrement.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool
+ConfFileProcessor::processConfSectionRouting(const ConfigSection& section)
+{
+  // worker-threads
+  ConfigurationVariable<uint32_t> workerThreads("worker-threads",
+                                                std::bind(&ConfParameter::setRoutingWorkerThreads,
+                                                &m_confParam, _1));
+  workerThreads.setMinAndMaxValue(ROUTING_WORKER_THREADS_MIN, ROUTING_WORKER_THREADS_MAX);
+  workerThreads.setOptional(ROUTING_WORKER_THREADS_DEFAULT);
+
+  if (!workerThreads.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // incremental-spf
+  std::string incrementalSpf = section.get<std::string>("incremental-spf", "on");
+
+  if (boost::iequals(incrementalSpf, "off")) {
+    m_confParam.setIncrementalSpfState(INCREMENTAL_SPF_OFF);
+  }
+  else if (boost::iequals(incrementalSpf, "on")) {
+    m_confParam.setIncrementalSpfState(INCREMENTAL_SPF_ON);
+  }
+  else if (boost::iequals(incrementalSpf, "validate")) {
+    m_confParam.setIncrementalSpfState(INCREMENTAL_SPF_VALIDATE);
+  }
+  else {
+    std::cerr << "Invalid setting for incremental-spf. "
+              << "Allowed values: off, on, validate" << std::endl;
+    return false;
+  }
+
+  // fast-reroute
+  std::string fastReroute = section.get<std::string>("fast-reroute", "off");
+
+  if (boost::iequals(fastReroute, "off")) {
+    m_confParam.setFastRerouteEnabled(false);
+  }
+  else if (boost::iequals(fastReroute, "on")) {
+    m_confParam.setFastRerouteEnabled(true);
+  }
+  else {
+    std::cerr << "Invalid setting for fast-reroute. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
+  // async-calculation
+  std::string asyncCalculation = section.get<std::string>("async-calculation", "off");
+
+  if (boost::iequals(asyncCalculation, "off")) {
+    m_confParam.setAsyncCalculationEnabled(false);
+  }
+  else if (boost::iequals(asyncCalculation, "on")) {
+    m_confParam.setAsyncCalculationEnabled(true);
+  }
+  else {
+    std::cerr << "Invalid setting for async-calculation. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
   return true;
 }
 
@@ -622,6 +751,16 @@ ConfFileProcessor::processConfSectionAdvertising(const ConfigSection& section)
      }
     }
   }
+
+  // Prefixes saved at runtime are kept in a journal next to the dynamic configuration file
+  if (!m_confParam.getConfFileNameDynamic().empty()) {
+    update::PrefixJournal journal(
+      update::makePrefixJournalFileName(m_confParam.getConfFileNameDynamic()));
+    journal.load();
+    for (const auto& prefix : journal.getPrefixes()) {
+      m_confParam.getNamePrefixList().insert(prefix);
+    }
+  }
   return true;
 }
 
@@ -99,6 +99,11 @@ private:
   bool
   processConfSectionFib(const ConfigSection& section);
 
+  /*! \brief Set options for the routing calculation: number of worker threads, incremental SPF.
+   */
+  bool
+  processConfSectionRouting(const ConfigSection& section);
+
   /*! \brief Set prefixes that NLSR is supposed to advertise immediately.
    */
   bool
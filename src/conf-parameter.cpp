@@ -41,8 +41,13 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_lsaRefreshTime(LSA_REFRESH_TIME_DEFAULT)
   , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
   , m_routingCalcInterval(ROUTING_CALC_INTERVAL_DEFAULT)
+  , m_routingCalcInitialWait(ROUTING_CALC_INITIAL_WAIT_DEFAULT)
+  , m_routingCalcIncrement(ROUTING_CALC_INCREMENT_DEFAULT)
   , m_faceDatasetFetchInterval(ndn::time::seconds(static_cast<int>(FACE_DATASET_FETCH_INTERVAL_DEFAULT)))
   , m_lsaInterestLifetime(ndn::time::seconds(static_cast<int>(LSA_INTEREST_LIFETIME_DEFAULT)))
+  , m_maxConcurrentLsaFetches(MAX_CONCURRENT_LSA_FETCHES_DEFAULT)
+  , m_isNameLsaDeltasEnabled(false)
+  , m_nameLsaBuildInterval(ndn::time::milliseconds(NAME_LSA_BUILD_INTERVAL_DEFAULT))
   , m_routerDeadInterval(2 * LSA_REFRESH_TIME_DEFAULT)
   , m_interestRetryNumber(HELLO_RETRIES_DEFAULT)
   , m_interestResendTime(HELLO_TIMEOUT_DEFAULT)
@@ -50,7 +55,14 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_hyperbolicState(HYPERBOLIC_STATE_OFF)
   , m_corR(0)
   , m_maxFacesPerPrefix(MAX_FACES_PER_PREFIX_MIN)
+  , m_routingWorkerThreads(ROUTING_WORKER_THREADS_DEFAULT)
+  , m_incrementalSpfState(INCREMENTAL_SPF_ON)
+  , m_isFastRerouteEnabled(false)
+  , m_isAsyncCalculationEnabled(false)
   , m_syncInterestLifetime(ndn::time::milliseconds(SYNC_INTEREST_LIFETIME_DEFAULT))
+  , m_processingTimeWeight(0.7)
+  , m_loadWeight(0.3)
+  , m_serviceEnabled(false)
   , m_adjl()
   , m_npl()
   , m_validator(makeCertificateFetcher(face))
@@ -74,6 +86,9 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("LSA refresh time: " << m_lsaRefreshTime);
   NLSR_LOG_INFO("FIB Entry refresh time: " << m_lsaRefreshTime * 2);
   NLSR_LOG_INFO("LSA Interest lifetime: " << getLsaInterestLifetime());
+  NLSR_LOG_INFO("Max concurrent LSA fetches: " << m_maxConcurrentLsaFetches);
+  NLSR_LOG_INFO("Name LSA deltas: " << m_isNameLsaDeltasEnabled);
+  NLSR_LOG_INFO("Name LSA build interval: " << m_nameLsaBuildInterval);
   NLSR_LOG_INFO("Router dead interval: " << getRouterDeadInterval());
   NLSR_LOG_INFO("Max Faces Per Prefix: " << m_maxFacesPerPrefix);
   if (m_hyperbolicState == HYPERBOLIC_STATE_ON || m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
@@ -89,6 +104,12 @@ ConfParameter::writeLog()
   // Event Intervals
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
   NLSR_LOG_INFO("Routing calculation interval:  " << m_routingCalcInterval);
+  NLSR_LOG_INFO("Routing calculation initial wait:  " << m_routingCalcInitialWait);
+  NLSR_LOG_INFO("Routing calculation increment:  " << m_routingCalcIncrement);
+  NLSR_LOG_INFO("Routing worker threads: " << m_routingWorkerThreads);
+  NLSR_LOG_INFO("Incremental SPF: " << m_incrementalSpfState);
+  NLSR_LOG_INFO("Fast reroute: " << m_isFastRerouteEnabled);
+  NLSR_LOG_INFO("Asynchronous calculation: " << m_isAsyncCalculationEnabled);
 }
 
 void
@@ -53,6 +53,18 @@ enum {
   LSA_INTEREST_LIFETIME_MAX = 60
 };
 
+enum {
+  MAX_CONCURRENT_LSA_FETCHES_MIN = 1,
+  MAX_CONCURRENT_LSA_FETCHES_DEFAULT = 16,
+  MAX_CONCURRENT_LSA_FETCHES_MAX = 1000
+};
+
+enum {
+  NAME_LSA_BUILD_INTERVAL_MIN = 0,
+  NAME_LSA_BUILD_INTERVAL_DEFAULT = 100,
+  NAME_LSA_BUILD_INTERVAL_MAX = 10000
+};
+
 enum {
   ADJ_LSA_BUILD_INTERVAL_MIN = 5,
   ADJ_LSA_BUILD_INTERVAL_DEFAULT = 10,
@@ -65,6 +77,18 @@ enum {
   ROUTING_CALC_INTERVAL_MAX = 15
 };
 
+enum {
+  ROUTING_CALC_INITIAL_WAIT_MIN = 0,
+  ROUTING_CALC_INITIAL_WAIT_DEFAULT = 50,
+  ROUTING_CALC_INITIAL_WAIT_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_INCREMENT_MIN = 1,
+  ROUTING_CALC_INCREMENT_DEFAULT = 200,
+  ROUTING_CALC_INCREMENT_MAX = 15000
+};
+
 
 enum {
   FACE_DATASET_FETCH_TRIES_MIN = 1,
@@ -102,6 +126,19 @@ enum {
   MAX_FACES_PER_PREFIX_MAX = 60
 };
 
+enum {
+  ROUTING_WORKER_THREADS_MIN = 1,
+  ROUTING_WORKER_THREADS_DEFAULT = 1,
+  ROUTING_WORKER_THREADS_MAX = 64
+};
+
+enum IncrementalSpfState {
+  INCREMENTAL_SPF_OFF = 0,
+  INCREMENTAL_SPF_ON = 1,
+  INCREMENTAL_SPF_VALIDATE = 2,
+  INCREMENTAL_SPF_DEFAULT = 1
+};
+
 enum HyperbolicState {
   HYPERBOLIC_STATE_OFF = 0,
   HYPERBOLIC_STATE_ON = 1,
@@ -243,6 +280,42 @@ public:
     return m_lsaInterestLifetime;
   }
 
+  void
+  setMaxConcurrentLsaFetches(uint32_t maxFetches)
+  {
+    m_maxConcurrentLsaFetches = maxFetches;
+  }
+
+  uint32_t
+  getMaxConcurrentLsaFetches() const
+  {
+    return m_maxConcurrentLsaFetches;
+  }
+
+  void
+  setNameLsaDeltasEnabled(bool enabled)
+  {
+    m_isNameLsaDeltasEnabled = enabled;
+  }
+
+  bool
+  isNameLsaDeltasEnabled() const
+  {
+    return m_isNameLsaDeltasEnabled;
+  }
+
+  void
+  setNameLsaBuildInterval(uint32_t interval)
+  {
+    m_nameLsaBuildInterval = ndn::time::milliseconds(interval);
+  }
+
+  const ndn::time::milliseconds&
+  getNameLsaBuildInterval() const
+  {
+    return m_nameLsaBuildInterval;
+  }
+
   void
   setAdjLsaBuildInterval(uint32_t interval)
   {
@@ -267,6 +340,30 @@ public:
     return m_routingCalcInterval;
   }
 
+  void
+  setRoutingCalcInitialWait(uint32_t initialWait)
+  {
+    m_routingCalcInitialWait = initialWait;
+  }
+
+  uint32_t
+  getRoutingCalcInitialWait() const
+  {
+    return m_routingCalcInitialWait;
+  }
+
+  void
+  setRoutingCalcIncrement(uint32_t increment)
+  {
+    m_routingCalcIncrement = increment;
+  }
+
+  uint32_t
+  getRoutingCalcIncrement() const
+  {
+    return m_routingCalcIncrement;
+  }
+
   void
   setRouterDeadInterval(uint32_t rdt)
   {
@@ -391,6 +488,54 @@ public:
     return m_maxFacesPerPrefix;
   }
 
+  void
+  setRoutingWorkerThreads(uint32_t nThreads)
+  {
+    m_routingWorkerThreads = nThreads;
+  }
+
+  uint32_t
+  getRoutingWorkerThreads() const
+  {
+    return m_routingWorkerThreads;
+  }
+
+  void
+  setIncrementalSpfState(IncrementalSpfState state)
+  {
+    m_incrementalSpfState = state;
+  }
+
+  IncrementalSpfState
+  getIncrementalSpfState() const
+  {
+    return m_incrementalSpfState;
+  }
+
+  void
+  setFastRerouteEnabled(bool enabled)
+  {
+    m_isFastRerouteEnabled = enabled;
+  }
+
+  bool
+  isFastRerouteEnabled() const
+  {
+    return m_isFastRerouteEnabled;
+  }
+
+  void
+  setAsyncCalculationEnabled(bool enabled)
+  {
+    m_isAsyncCalculationEnabled = enabled;
+  }
+
+  bool
+  isAsyncCalculationEnabled() const
+  {
+    return m_isAsyncCalculationEnabled;
+  }
+
   void
   setStateFileDir(const std::string& ssfd)
   {
@@ -557,11 +702,16 @@ private:
 
   uint32_t m_adjLsaBuildInterval;
   uint32_t m_routingCalcInterval;
+  uint32_t m_routingCalcInitialWait;
+  uint32_t m_routingCalcIncrement;
 
   uint32_t m_faceDatasetFetchTries;
   ndn::time::seconds m_faceDatasetFetchInterval;
 
   ndn::time::seconds m_lsaInterestLifetime;
+  uint32_t m_maxConcurrentLsaFetches;
+  bool m_isNameLsaDeltasEnabled;
+  ndn::time::milliseconds m_nameLsaBuildInterval;
   uint32_t  m_routerDeadInterval;
 
   uint32_t m_interestRetryNumber;
@@ -574,6 +724,10 @@ private:
   std::vector<double> m_corTheta;
 
   uint32_t m_maxFacesPerPrefix;
+  uint32_t m_routingWorkerThreads;
+  IncrementalSpfState m_incrementalSpfState;
+  bool m_isFastRerouteEnabled;
+  bool m_isAsyncCalculationEnabled;
 
   std::string m_stateFileDir;
 
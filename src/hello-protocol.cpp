@@ -191,6 +191,12 @@ HelloProtocol::processInterestTimedOut(const ndn::Interest& interest)
 
     NLSR_LOG_DEBUG("Neighbor: " << neighbor << " status changed to INACTIVE");
 
+    // Stop forwarding through the neighbor until the routing table is recalculated
+    auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+    if (adjacent != m_adjacencyList.end()) {
+      m_routingTable.switchToBackupNextHops(adjacent->getFaceUri());
+    }
+
     if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
       m_routingTable.scheduleRoutingTableCalculation();
     }
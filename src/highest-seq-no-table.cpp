@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "highest-seq-no-table.hpp"
+
+namespace nlsr {
+
+bool
+HighestSeqNoTable::insert(const ndn::Name& router, Lsa::Type lsaType, uint64_t seqNo)
+{
+  auto [it, isNew] = m_routerIds.try_emplace(router, 0);
+  if (isNew) {
+    if (m_freeIds.empty()) {
+      it->second = static_cast<uint32_t>(m_entries.size());
+      m_entries.emplace_back();
+    }
+    else {
+      it->second = m_freeIds.back();
+      m_freeIds.pop_back();
+    }
+  }
+
+  auto& entry = m_entries[it->second];
+  auto type = static_cast<size_t>(lsaType);
+  uint8_t bit = 1 << type;
+  if ((entry.known & bit) && seqNo < entry.seqNo[type]) {
+    return false;
+  }
+  entry.seqNo[type] = seqNo;
+  entry.known |= bit;
+  return true;
+}
+
+std::optional<uint64_t>
+HighestSeqNoTable::find(const ndn::Name& router, Lsa::Type lsaType) const
+{
+  auto it = m_routerIds.find(router);
+  if (it == m_routerIds.end()) {
+    return std::nullopt;
+  }
+  const auto& entry = m_entries[it->second];
+  auto type = static_cast<size_t>(lsaType);
+  if (!(entry.known & (1 << type))) {
+    return std::nullopt;
+  }
+  return entry.seqNo[type];
+}
+
+void
+HighestSeqNoTable::erase(const ndn::Name& router, Lsa::Type lsaType)
+{
+  auto it = m_routerIds.find(router);
+  if (it == m_routerIds.end()) {
+    return;
+  }
+  auto& entry = m_entries[it->second];
+  entry.known &= ~(1 << static_cast<size_t>(lsaType));
+  if (entry.known == 0) {
+    entry = Entry{};
+    m_freeIds.push_back(it->second);
+    m_routerIds.erase(it);
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_HIGHEST_SEQ_NO_TABLE_HPP
+#define NLSR_HIGHEST_SEQ_NO_TABLE_HPP
+
+#include "common.hpp"
+#include "lsa/lsa.hpp"
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+
+namespace nlsr {
+
+/*! \brief Highest sequence number heard from sync for each LSA of other routers.
+
+  The LSDB uses these to avoid fetching outdated LSAs. Router names are interned once into
+  small integer ids; the sequence numbers of all LSA types of a router are kept together in
+  a flat vector indexed by that id. An entry is reclaimed, and its id reused, once the LSAs
+  of all types of its router have been erased.
+ */
+class HighestSeqNoTable
+{
+public:
+  /*! \brief Record that @p seqNo is available for an LSA.
+    \return false if a higher sequence number is already known, i.e. @p seqNo is outdated.
+   */
+  bool
+  insert(const ndn::Name& router, Lsa::Type lsaType, uint64_t seqNo);
+
+  /*! \brief Return the highest known sequence number of an LSA, if any.
+   */
+  std::optional<uint64_t>
+  find(const ndn::Name& router, Lsa::Type lsaType) const;
+
+  /*! \brief Forget the sequence number of an LSA.
+   */
+  void
+  erase(const ndn::Name& router, Lsa::Type lsaType);
+
+  /*! \brief Return the number of routers with a known sequence number.
+   */
+  size_t
+  size() const
+  {
+    return m_routerIds.size();
+  }
+
+private:
+  static constexpr size_t N_TYPES = static_cast<size_t>(Lsa::Type::BASE) + 1;
+
+  struct Entry
+  {
+    std::array<uint64_t, N_TYPES> seqNo{};
+    /// Bit @c i is set if seqNo[i] is known
+    uint8_t known = 0;
+  };
+
+  std::unordered_map<ndn::Name, uint32_t> m_routerIds;
+  std::vector<Entry> m_entries;
+  std::vector<uint32_t> m_freeIds;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_HIGHEST_SEQ_NO_TABLE_HPP
@@ -126,7 +126,7 @@ AdjLsa::print(std::ostream& os) const
   }
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 AdjLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto alsa = std::static_pointer_cast<AdjLsa>(lsa);
@@ -135,9 +135,9 @@ AdjLsa::update(const std::shared_ptr<Lsa>& lsa)
     for (const auto& adjacent : alsa->getAdl()) {
       addAdjacent(adjacent);
     }
-    return {true, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+    return {true, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
   }
-  return {false, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+  return {false, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
 }
 
 } // namespace nlsr
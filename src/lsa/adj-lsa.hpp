@@ -107,7 +107,7 @@ public:
   void
   wireDecode(const ndn::Block& wire);
 
-  std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
 private:
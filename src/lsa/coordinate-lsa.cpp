@@ -22,6 +22,8 @@
 #include "coordinate-lsa.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <cmath>
+
 namespace nlsr {
 
 CoordinateLsa::CoordinateLsa(const ndn::Name& originRouter, uint64_t seqNo,
@@ -31,6 +33,7 @@ CoordinateLsa::CoordinateLsa(const ndn::Name& originRouter, uint64_t seqNo,
   , m_hyperbolicRadius(radius)
   , m_hyperbolicAngles(angles)
 {
+  computeEmbedding();
 }
 
 CoordinateLsa::CoordinateLsa(const ndn::Block& block)
@@ -117,6 +120,33 @@ CoordinateLsa::wireDecode(const ndn::Block& wire)
     }
   }
   m_hyperbolicAngles = angles;
+  computeEmbedding();
+}
+
+void
+CoordinateLsa::computeEmbedding()
+{
+  m_coshRadius = std::cosh(m_hyperbolicRadius);
+  m_sinhRadius = std::sinh(m_hyperbolicRadius);
+
+  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+  m_unitVector.clear();
+  size_t nAngles = m_hyperbolicAngles.size();
+  if (nAngles == 0 || m_hyperbolicAngles.back() < 0.0 || m_hyperbolicAngles.back() > 2. * M_PI) {
+    return;
+  }
+
+  // x_m = cos(θ_m) * sin(θ_0) * ... * sin(θ_{m-1}) for m < d, and the last component is
+  // sin(θ_{d-1}) times the same product of sines
+  m_unitVector.reserve(nAngles + 1);
+  double sinProduct = 1.0;
+  for (size_t m = 0; m < nAngles; ++m) {
+    m_unitVector.push_back(std::cos(m_hyperbolicAngles[m]) * sinProduct);
+    if (m + 1 < nAngles) {
+      sinProduct *= std::sin(m_hyperbolicAngles[m]);
+    }
+  }
+  m_unitVector.push_back(std::sin(m_hyperbolicAngles.back()) * sinProduct);
 }
 
 void
@@ -129,7 +159,7 @@ CoordinateLsa::print(std::ostream& os) const
   }
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 CoordinateLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto clsa = std::static_pointer_cast<CoordinateLsa>(lsa);
@@ -139,9 +169,10 @@ CoordinateLsa::update(const std::shared_ptr<Lsa>& lsa)
     for (const auto& angle : clsa->getTheta()) {
       m_hyperbolicAngles.push_back(angle);
     }
-    return {true, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+    computeEmbedding();
+    return {true, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
   }
-  return {false, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+  return {false, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
 }
 
 } // namespace nlsr
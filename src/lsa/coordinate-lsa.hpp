@@ -81,6 +81,7 @@ public:
   {
     m_wire.reset();
     m_hyperbolicRadius = cr;
+    computeEmbedding();
   }
 
   const std::vector<double>&
@@ -94,6 +95,33 @@ public:
   {
     m_wire.reset();
     m_hyperbolicAngles = std::move(ct);
+    computeEmbedding();
+  }
+
+  /**
+   * @brief Return the Cartesian coordinates of the angles, as a unit vector.
+   *
+   * A router with angles (θ_0, ..., θ_{d-1}) lies on a d-sphere, so the vector has d + 1
+   * components. It is empty if the last angle is not within [0, 2π].
+   */
+  const std::vector<double>&
+  getUnitVector() const
+  {
+    return m_unitVector;
+  }
+
+  /// Return cosh of the radius, as used by the hyperbolic distance
+  double
+  getCoshRadius() const
+  {
+    return m_coshRadius;
+  }
+
+  /// Return sinh of the radius, as used by the hyperbolic distance
+  double
+  getSinhRadius() const
+  {
+    return m_sinhRadius;
   }
 
   template<ndn::encoding::Tag TAG>
@@ -106,13 +134,22 @@ public:
   void
   wireDecode(const ndn::Block& wire);
 
-  std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
 private:
   void
   print(std::ostream& os) const override;
 
+  /**
+   * @brief Convert the coordinates into the form used by the routing calculation.
+   *
+   * This runs whenever the coordinates change, so that the calculation does not repeat the
+   * trigonometry for every pair of routers.
+   */
+  void
+  computeEmbedding();
+
 private: // non-member operators
   // NOTE: the following "hidden friend" operators are available via
   //       argument-dependent lookup only and must be defined inline.
@@ -130,6 +167,10 @@ private: // non-member operators
 private:
   double m_hyperbolicRadius = 0.0;
   std::vector<double> m_hyperbolicAngles;
+
+  std::vector<double> m_unitVector;
+  double m_coshRadius = 1.0;
+  double m_sinhRadius = 0.0;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(CoordinateLsa);
@@ -25,10 +25,9 @@
 #include "common.hpp"
 #include "name-prefix-list.hpp"
 #include "test-access-control.hpp"
+#include "utility/timer-wheel.hpp"
 
-#include <ndn-cxx/util/scheduler.hpp>
-
-#include <list>
+#include <vector>
 
 
 namespace nlsr {
@@ -109,12 +108,12 @@ public:
   }
 
   void
-  setExpiringEventId(ndn::scheduler::EventId eid)
+  setExpiringEventId(util::TimerWheel::EventId eid)
   {
     m_expiringEventId = eid;
   }
 
-  virtual std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  virtual std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) = 0;
 
   virtual const ndn::Block&
@@ -139,7 +138,7 @@ PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   ndn::Name m_originRouter;
   uint64_t m_seqNo = 0;
   ndn::time::system_clock::time_point m_expirationTimePoint;
-  ndn::scheduler::ScopedEventId m_expiringEventId;
+  util::TimerWheel::ScopedEventId m_expiringEventId;
 
   mutable ndn::Block m_wire;
 };
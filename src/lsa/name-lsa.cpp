@@ -20,6 +20,8 @@
  */
 
 #include "name-lsa.hpp"
+#include "tlv-nlsr.hpp"
+
 #include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
@@ -37,6 +39,19 @@ NameLsa::NameLsa(const ndn::Name& originRouter, uint64_t seqNo,
   }
 }
 
+NameLsa::NameLsa(const ndn::Name& originRouter, uint64_t seqNo,
+                 const ndn::time::system_clock::time_point& timepoint,
+                 uint64_t baseSeqNo, const NamePrefixList& added, const NamePrefixList& removed,
+                 double processingTime, double loadIndex)
+  : Lsa(originRouter, seqNo, timepoint)
+  , m_npl(added)
+  , m_processingTime(processingTime)
+  , m_loadIndex(loadIndex)
+  , m_baseSeqNo(baseSeqNo)
+  , m_removedNpl(removed)
+{
+}
+
 NameLsa::NameLsa(const ndn::Block& block)
 {
   wireDecode(block);
@@ -46,6 +61,10 @@ template<ndn::encoding::Tag TAG>
 size_t
 NameLsa::wireEncode(ndn::encoding::EncodingImpl<TAG>& encoder) const
 {
+  if (m_baseSeqNo) {
+    return wireEncodeDelta(encoder);
+  }
+
   size_t totalLength = 0;
 
   // エンコードプロセス
@@ -75,6 +94,40 @@ NameLsa::wireEncode(ndn::encoding::EncodingImpl<TAG>& encoder) const
   return totalLength;
 }
 
+template<ndn::encoding::Tag TAG>
+size_t
+NameLsa::wireEncodeDelta(ndn::encoding::EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  auto removed = m_removedNpl.getNames();
+  for (auto it = removed.rbegin(); it != removed.rend(); ++it) {
+    totalLength += ndn::encoding::prependNestedBlock(encoder, tlv::PrefixRetraction, *it);
+  }
+
+  auto added = m_npl.getSortedView();
+  for (auto it = added.rbegin(); it != added.rend(); ++it) {
+    size_t announcementLength = ndn::encoding::prependDoubleBlock(encoder, tlv::Cost,
+                                                                  (*it)->getCost());
+    announcementLength += (*it)->getName().wireEncode(encoder);
+    announcementLength += encoder.prependVarNumber(announcementLength);
+    announcementLength += encoder.prependVarNumber(tlv::PrefixAnnouncement);
+    totalLength += announcementLength;
+  }
+
+  totalLength += ndn::encoding::prependDoubleBlock(encoder, tlv::LoadIndex, m_loadIndex);
+  totalLength += ndn::encoding::prependDoubleBlock(encoder, tlv::ProcessingTime,
+                                                   m_processingTime);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::BaseSequenceNumber, *m_baseSeqNo);
+
+  totalLength += Lsa::wireEncode(encoder);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::NameLsaDelta);
+
+  return totalLength;
+}
+
 const ndn::Block&
 NameLsa::wireEncode() const
 {
@@ -95,6 +148,11 @@ NameLsa::wireEncode() const
 void
 NameLsa::wireDecode(const ndn::Block& wire)
 {
+  if (wire.type() == tlv::NameLsaDelta) {
+    wireDecodeDelta(wire);
+    return;
+  }
+
   m_wire = wire;
   m_wire.parse();
 
@@ -117,6 +175,63 @@ NameLsa::wireDecode(const ndn::Block& wire)
   }
 }
 
+void
+NameLsa::wireDecodeDelta(const ndn::Block& wire)
+{
+  m_wire = wire;
+  m_wire.parse();
+  m_npl.clear();
+  m_removedNpl.clear();
+  m_processingTime = 0.0;
+  m_loadIndex = 0.0;
+
+  auto val = m_wire.elements_begin();
+
+  if (val != m_wire.elements_end() && val->type() == tlv::Lsa) {
+    Lsa::wireDecode(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required Lsa field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::BaseSequenceNumber) {
+    m_baseSeqNo = ndn::readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required BaseSequenceNumber field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::ProcessingTime) {
+    m_processingTime = decodeDouble(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required ProcessingTime field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::LoadIndex) {
+    m_loadIndex = decodeDouble(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required LoadIndex field"));
+  }
+
+  for (; val != m_wire.elements_end(); ++val) {
+    if (val->type() == tlv::PrefixAnnouncement) {
+      val->parse();
+      m_npl.insert(PrefixInfo(ndn::Name(val->get(ndn::tlv::Name)),
+                              decodeDouble(val->get(tlv::Cost))));
+    }
+    else if (val->type() == tlv::PrefixRetraction) {
+      val->parse();
+      m_removedNpl.insert(ndn::Name(val->get(ndn::tlv::Name)));
+    }
+  }
+}
+
 bool
 NameLsa::isEqualContent(const NameLsa& other) const
 {
@@ -125,42 +240,69 @@ NameLsa::isEqualContent(const NameLsa& other) const
          m_loadIndex == other.m_loadIndex;
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 NameLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
-  std::list<PrefixInfo> added;
-  std::list<PrefixInfo> removed;
-
-  if (!lsa) {
-    return std::make_tuple(false, added, removed);
-  }
-
   auto nameLsa = std::dynamic_pointer_cast<NameLsa>(lsa);
   if (!nameLsa) {
-    return std::make_tuple(false, added, removed);
+    return {false, {}, {}};
   }
 
-  bool isUpdated = false;
+  if (nameLsa->isDelta()) {
+    return applyDelta(*nameLsa);
+  }
 
-  // 新しい名前の追加
-  for (const auto& name : nameLsa->getNpl()) {
-    if (m_npl.find(name) == m_npl.end()) {
-      m_npl.insert(name);
-      added.push_back(PrefixInfo(name));
-      isUpdated = true;
+  // Both views are sorted by name, so one merge finds every difference. The merge only
+  // collects entries of the views, and m_npl is modified after it, as that invalidates its view.
+  auto oldPrefixes = m_npl.getSortedView();
+  auto newPrefixes = nameLsa->getNpl().getSortedView();
+  std::vector<const PrefixInfo*> toAdd;
+  std::vector<const PrefixInfo*> toRemove;
+  toAdd.reserve(newPrefixes.size());
+  toRemove.reserve(oldPrefixes.size());
+
+  auto oldIt = oldPrefixes.begin();
+  auto newIt = newPrefixes.begin();
+  while (oldIt != oldPrefixes.end() && newIt != newPrefixes.end()) {
+    int order = (*oldIt)->getName().compare((*newIt)->getName());
+    if (order < 0) {
+      toRemove.push_back(*oldIt++);
+    }
+    else if (order > 0) {
+      toAdd.push_back(*newIt++);
+    }
+    else {
+      // A new cost is reported as an addition, which updates the cost of the existing entry
+      if ((*oldIt)->getCost() != (*newIt)->getCost()) {
+        toAdd.push_back(*newIt);
+      }
+      ++oldIt;
+      ++newIt;
     }
   }
+  toRemove.insert(toRemove.end(), oldIt, oldPrefixes.end());
+  toAdd.insert(toAdd.end(), newIt, newPrefixes.end());
+
+  std::vector<PrefixInfo> added;
+  std::vector<PrefixInfo> removed;
+  added.reserve(toAdd.size());
+  removed.reserve(toRemove.size());
+  for (const auto* info : toAdd) {
+    added.push_back(*info);
+  }
+  for (const auto* info : toRemove) {
+    removed.push_back(*info);
+  }
 
-  // 古い名前の削除
-  for (const auto& name : m_npl) {
-    if (nameLsa->getNpl().find(name) == nameLsa->getNpl().end()) {
-      removed.push_back(PrefixInfo(name));
-      m_npl.remove(name);
-      isUpdated = true;
-    }
+  for (const auto& info : removed) {
+    m_npl.remove(info.getName());
   }
+  for (const auto& info : added) {
+    m_npl.insert(info);
+  }
+
+  bool isUpdated = !added.empty() || !removed.empty();
 
-  // 処理時間と負荷指数の更新
   if (m_processingTime != nameLsa->getProcessingTime()) {
     m_processingTime = nameLsa->getProcessingTime();
     isUpdated = true;
@@ -171,12 +313,60 @@ NameLsa::update(const std::shared_ptr<Lsa>& lsa)
     isUpdated = true;
   }
 
-  return std::make_tuple(isUpdated, added, removed);
+  if (isUpdated) {
+    m_wire.reset();
+  }
+  return {isUpdated, std::move(added), std::move(removed)};
+}
+
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
+NameLsa::applyDelta(const NameLsa& delta)
+{
+  std::vector<PrefixInfo> added;
+  std::vector<PrefixInfo> removed;
+  added.reserve(delta.m_npl.size());
+  removed.reserve(delta.m_removedNpl.size());
+
+  for (const auto* info : delta.m_npl.getSortedView()) {
+    // A new cost is reported as an addition, as in update()
+    if (!m_npl.contains(info->getName()) ||
+        m_npl.getPrefixInfoForName(info->getName()).getCost() != info->getCost()) {
+      m_npl.insert(*info);
+      added.push_back(*info);
+    }
+  }
+
+  for (const auto* info : delta.m_removedNpl.getSortedView()) {
+    if (m_npl.contains(info->getName())) {
+      removed.push_back(m_npl.getPrefixInfoForName(info->getName()));
+      m_npl.remove(info->getName());
+    }
+  }
+
+  bool isUpdated = !added.empty() || !removed.empty();
+  if (m_processingTime != delta.m_processingTime || m_loadIndex != delta.m_loadIndex) {
+    m_processingTime = delta.m_processingTime;
+    m_loadIndex = delta.m_loadIndex;
+    isUpdated = true;
+  }
+
+  m_wire.reset();
+  return {isUpdated, std::move(added), std::move(removed)};
 }
 
 void
 NameLsa::print(std::ostream& os) const
 {
+  if (m_baseSeqNo) {
+    os << "      Delta from Sequence Number: " << *m_baseSeqNo << "\n";
+    os << "      Removed Names:\n";
+    int i = 0;
+    for (const auto& name : m_removedNpl.getNames()) {
+      os << "        Name " << i << ": " << name << "\n";
+      i++;
+    }
+  }
+
   os << "      Names:\n";
   int i = 0;
   for (const auto& name : m_npl.getPrefixInfo()) {
@@ -27,6 +27,8 @@
 #include <ndn-cxx/util/time.hpp>
 #include <boost/operators.hpp>
 
+#include <optional>
+
 namespace nlsr {
 
 /**
@@ -38,6 +40,19 @@ namespace nlsr {
  *             Lsa
  *             1*Name
  * @endcode
+ *
+ * A Name LSA can instead be a delta, carrying only the prefixes added and removed since
+ * an earlier version of the LSA of the same router, the base. The router metrics are always
+ * carried, as the calculation reads them:
+ * @code{.abnf}
+ * NameLsaDelta = NAME-LSA-DELTA-TYPE TLV-LENGTH
+ *                  Lsa
+ *                  BaseSequenceNumber
+ *                  ProcessingTime
+ *                  LoadIndex
+ *                  *PrefixAnnouncement ; added or with a new cost, contains a Name and a Cost
+ *                  *PrefixRetraction ; removed, contains a Name
+ * @endcode
  */
 class NameLsa : public Lsa, private boost::equality_comparable<NameLsa>
 {
@@ -62,12 +77,51 @@ public:
   {
   }
 
+  /**
+   * @brief Creates a delta that turns version @p baseSeqNo of the Name LSA of
+   *        @p originRouter into version @p sequenceNumber .
+   * @param added Prefixes that are added or whose cost changed, with their new cost.
+   * @param processingTime Processing time of version @p sequenceNumber .
+   * @param loadIndex Load index of version @p sequenceNumber .
+   */
+  NameLsa(const ndn::Name& originRouter, uint64_t sequenceNumber,
+          const ndn::time::system_clock::time_point& expirationTime,
+          uint64_t baseSeqNo, const NamePrefixList& added, const NamePrefixList& removed,
+          double processingTime = 0.0, double loadIndex = 0.0);
+
+  /**
+   * @brief Returns the prefixes of the LSA, or the added prefixes if it is a delta.
+   */
   const NamePrefixList&
   getNpl() const
   {
     return m_npl;
   }
 
+  bool
+  isDelta() const
+  {
+    return m_baseSeqNo.has_value();
+  }
+
+  /**
+   * @brief Returns the seq no of the version that a delta applies to.
+   */
+  std::optional<uint64_t>
+  getBaseSeqNo() const
+  {
+    return m_baseSeqNo;
+  }
+
+  /**
+   * @brief Returns the prefixes removed by a delta.
+   */
+  const NamePrefixList&
+  getRemovedNpl() const
+  {
+    return m_removedNpl;
+  }
+
   double
   getProcessingTime() const
   {
@@ -105,10 +159,27 @@ public:
   void
   wireDecode(const ndn::Block& wire);
 
-  virtual std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  /**
+   * @brief Updates the LSA to the content of @p lsa .
+   *
+   * If @p lsa is a delta, its added and removed prefixes and its metrics are applied; the
+   * caller makes sure that this LSA is its base. A prefix whose cost changes is reported as
+   * added, with the new cost.
+   */
+  virtual std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
 private:
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncodeDelta(ndn::encoding::EncodingImpl<TAG>& encoder) const;
+
+  void
+  wireDecodeDelta(const ndn::Block& wire);
+
+  std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
+  applyDelta(const NameLsa& delta);
+
   static double
   decodeDouble(const ndn::Block& block)
   {
@@ -119,6 +190,9 @@ private:
   double m_processingTime;
   double m_loadIndex;
 
+  std::optional<uint64_t> m_baseSeqNo;
+  NamePrefixList m_removedNpl;
+
   mutable ndn::Block m_wire;
 };
 
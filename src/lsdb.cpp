@@ -23,9 +23,11 @@
 
 #include "logger.hpp"
 #include "nlsr.hpp"
+#include "tlv-nlsr.hpp"
 #include "utility/name-helper.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/util/random.hpp>
 
 namespace nlsr {
 
@@ -34,6 +36,7 @@ INIT_LOGGER(Lsdb);
 Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   : m_face(face)
   , m_scheduler(face.getIoContext())
+  , m_timerWheel(m_scheduler)
   , m_confParam(confParam)
   , m_sync(m_face, keyChain,
       [this] (const auto& routerName, Lsa::Type lsaType, uint64_t seqNo, uint64_t) {
@@ -59,9 +62,9 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
         expressInterest(lsaInterest, 0, incomingFaceId);
       }))
   , m_segmenter(keyChain, m_confParam.getSigningInfo())
-  , m_segmentFifo(100)
   , m_isBuildAdjLsaScheduled(false)
   , m_adjBuildCount(0)
+  , m_isBuildNameLsaScheduled(false)
 {
   ndn::Name name = m_confParam.getLsaPrefix();
   NLSR_LOG_DEBUG("Setting interest filter for LsaPrefix: " << name);
@@ -84,14 +87,18 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
 
 Lsdb::~Lsdb()
 {
-  for (const auto& fetcher : m_fetchers) {
-    fetcher->stop();
+  for (const auto& [key, fetch] : m_fetchers) {
+    fetch.fetcher->stop();
   }
 }
 
 void
 Lsdb::buildAndInstallOwnNameLsa()
 {
+  // This build includes the changes that a scheduled build was waiting for
+  m_scheduledNameLsaBuild.cancel();
+  m_isBuildNameLsaScheduled = false;
+
   NameLsa nameLsa(m_thisRouterPrefix, m_sequencingManager.getNameLsaSeq() + 1,
                   getLsaExpirationTimePoint(), m_confParam.getNamePrefixList());
   m_sequencingManager.increaseNameLsaSeq();
@@ -101,6 +108,20 @@ Lsdb::buildAndInstallOwnNameLsa()
   installLsa(std::make_shared<NameLsa>(nameLsa));
 }
 
+void
+Lsdb::scheduleNameLsaBuild()
+{
+  if (m_isBuildNameLsaScheduled) {
+    NLSR_LOG_TRACE("Name LSA build already scheduled");
+    return;
+  }
+
+  auto interval = m_confParam.getNameLsaBuildInterval();
+  NLSR_LOG_DEBUG("Scheduling Name LSA build in " << interval);
+  m_isBuildNameLsaScheduled = true;
+  m_scheduledNameLsaBuild = m_scheduler.schedule(interval, [this] { buildAndInstallOwnNameLsa(); });
+}
+
 void
 Lsdb::buildAndInstallOwnCoordinateLsa()
 {
@@ -166,9 +187,9 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 
   if (interestName[-2].isVersion()) {
     // Interest for particular segment
-    auto data = m_segmentFifo.find(interestName);
+    auto data = findSignedSegment(interestName);
     if (data) {
-      NLSR_LOG_TRACE("Replying from FIFO buffer");
+      NLSR_LOG_TRACE("Replying from signed segment cache");
       m_face.put(*data);
       return;
     }
@@ -178,6 +199,13 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     NLSR_LOG_TRACE("Interest w/o segment and version: " << interestName);
   }
 
+  // Interest for the delta of a Name LSA from an earlier version
+  std::optional<uint64_t> baseSeqNo;
+  if (interestName.size() >= 2 && interestName[-2] == NAME_LSA_DELTA_COMPONENT) {
+    baseSeqNo = interestName[-1].toNumber();
+    interestName = interestName.getPrefix(-2);
+  }
+
   // increment RCV_LSA_INTEREST
   lsaIncrementSignal(Statistics::PacketType::RCV_LSA_INTEREST);
 
@@ -203,7 +231,7 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     }
 
     incrementInterestRcvdStats(interestedLsType);
-    if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo)) {
+    if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo, baseSeqNo)) {
       lsaIncrementSignal(Statistics::PacketType::SENT_LSA_DATA);
     }
   }
@@ -216,21 +244,21 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 
 bool
 Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
-                            Lsa::Type lsaType, uint64_t seqNo)
+                            Lsa::Type lsaType, uint64_t seqNo,
+                            std::optional<uint64_t> baseSeqNo)
 {
   NLSR_LOG_DEBUG(interest << " received for " << lsaType);
 
   if (auto lsaPtr = findLsa(originRouter, lsaType); lsaPtr) {
     NLSR_LOG_TRACE("Verifying SeqNo for " << lsaType << " is same as requested");
     if (lsaPtr->getSeqNo() == seqNo) {
-      auto segments = m_segmenter.segment(lsaPtr->wireEncode(),
-                                          ndn::Name(interest.getName()).appendVersion(),
-                                          ndn::MAX_NDN_PACKET_SIZE / 2, m_lsaRefreshTime);
-      for (const auto& data : segments) {
-        m_segmentFifo.insert(*data, m_lsaRefreshTime);
-        m_scheduler.schedule(m_lsaRefreshTime,
-                             [this, name = data->getName()] { m_segmentFifo.erase(name); });
+      ndn::Name lsaName = interest.getName();
+      if (lsaName.size() >= 2 && lsaName[-2].isVersion()) {
+        lsaName = lsaName.getPrefix(-2);
       }
+      const auto& segments = baseSeqNo && lsaType == Lsa::Type::NAME ?
+                             getSignedNameLsaDeltaSegments(*baseSeqNo, lsaName) :
+                             getSignedSegments(*lsaPtr);
 
       uint64_t segNum = 0;
       if (interest.getName()[-1].isSegment()) {
@@ -249,6 +277,148 @@ Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& orig
   return false;
 }
 
+const std::vector<std::shared_ptr<ndn::Data>>&
+Lsdb::getSignedSegments(const Lsa& lsa)
+{
+  auto& cached = m_segmentedLsas[lsa.getType()];
+  if (!cached.segments.empty() && cached.seqNo == lsa.getSeqNo()) {
+    NLSR_LOG_TRACE("Serving signed segments of " << cached.name << " from cache");
+    return cached.segments;
+  }
+
+  // The segments are named after the LSA rather than after the Interest, so that every form
+  // of Interest name for this version is answered by the same signing. Only the latest
+  // version of each LSA is kept, replacing the segments of older ones.
+  auto lsaName = makeLsaUserPrefix(m_confParam.getSyncUserPrefix(), lsa.getType())
+                   .appendNumber(lsa.getSeqNo());
+  cached.seqNo = lsa.getSeqNo();
+  signSegments(cached, lsaName, lsa.wireEncode());
+  return cached.segments;
+}
+
+const std::vector<std::shared_ptr<ndn::Data>>&
+Lsdb::getSignedNameLsaDeltaSegments(uint64_t baseSeqNo, const ndn::Name& lsaName)
+{
+  if (auto it = m_segmentedNameLsaDeltas.find(baseSeqNo);
+      it != m_segmentedNameLsaDeltas.end() && it->second.name == lsaName) {
+    NLSR_LOG_TRACE("Serving signed segments of " << lsaName << " from cache");
+    return it->second.segments;
+  }
+
+  if (m_segmentedNameLsaDeltas.size() >= NAME_LSA_DELTA_CACHE_MAX) {
+    // The lowest bases are past the change history, and only get the short reply
+    m_segmentedNameLsaDeltas.erase(m_segmentedNameLsaDeltas.begin());
+  }
+
+  // Without a delta, a short reply sends the receiver to the whole LSA under its plain name,
+  // whose segments are signed once for all receivers
+  auto delta = buildNameLsaDelta(baseSeqNo);
+  ndn::Block lsaWire = delta ? delta->wireEncode() : ndn::makeEmptyBlock(tlv::NameLsaNoDelta);
+  auto& cached = m_segmentedNameLsaDeltas[baseSeqNo];
+  signSegments(cached, lsaName, lsaWire);
+  return cached.segments;
+}
+
+void
+Lsdb::signSegments(SegmentedLsa& cached, const ndn::Name& lsaName, const ndn::Block& lsaWire)
+{
+  cached.name = lsaName;
+  cached.segments = m_segmenter.segment(lsaWire, ndn::Name(lsaName).appendVersion(),
+                                        ndn::MAX_NDN_PACKET_SIZE / 2, m_lsaRefreshTime);
+  NLSR_LOG_DEBUG("Signed " << cached.segments.size() << " segments of " << lsaName);
+  afterSegmentsSigned(cached.segments.size());
+}
+
+std::shared_ptr<NameLsa>
+Lsdb::buildNameLsaDelta(uint64_t baseSeqNo) const
+{
+  auto nameLsa = findLsa<NameLsa>(m_thisRouterPrefix);
+  if (nameLsa == nullptr || baseSeqNo >= nameLsa->getSeqNo() || m_nameLsaChanges.empty() ||
+      m_nameLsaChanges.back().seqNo != nameLsa->getSeqNo() ||
+      m_nameLsaChanges.front().seqNo > baseSeqNo + 1) {
+    return nullptr;
+  }
+
+  // Chain the changes after the base; a later change of a prefix overrides an earlier one
+  NamePrefixList added;
+  NamePrefixList removed;
+  for (const auto& change : m_nameLsaChanges) {
+    if (change.seqNo <= baseSeqNo) {
+      continue;
+    }
+    for (const auto& info : change.added.getPrefixInfo()) {
+      removed.erase(info.getName());
+      added.insert(info);
+    }
+    for (const auto& name : change.removed.getNames()) {
+      added.erase(name);
+      removed.insert(name);
+    }
+  }
+
+  if (added.size() + removed.size() >= nameLsa->getNpl().size()) {
+    return nullptr;
+  }
+  return std::make_shared<NameLsa>(m_thisRouterPrefix, nameLsa->getSeqNo(),
+                                   nameLsa->getExpirationTimePoint(), baseSeqNo, added, removed,
+                                   nameLsa->getProcessingTime(), nameLsa->getLoadIndex());
+}
+
+void
+Lsdb::recordNameLsaChange(uint64_t seqNo, const std::vector<PrefixInfo>& added,
+                          const std::vector<PrefixInfo>& removed)
+{
+  // Deltas to the previous version are outdated
+  m_segmentedNameLsaDeltas.clear();
+  if (!m_confParam.isNameLsaDeltasEnabled()) {
+    return;
+  }
+
+  if (!m_nameLsaChanges.empty() && m_nameLsaChanges.back().seqNo + 1 != seqNo) {
+    // The versions in between are unknown, so older changes cannot be chained to this one
+    m_nameLsaChanges.clear();
+  }
+
+  NameLsaChange change{seqNo, {}, {}};
+  for (const auto& info : added) {
+    change.added.insert(info);
+  }
+  for (const auto& info : removed) {
+    change.removed.insert(info.getName());
+  }
+  m_nameLsaChanges.push_back(std::move(change));
+  if (m_nameLsaChanges.size() > NAME_LSA_CHANGES_MAX) {
+    m_nameLsaChanges.pop_front();
+  }
+}
+
+std::shared_ptr<const ndn::Data>
+Lsdb::findSignedSegment(const ndn::Name& segmentName) const
+{
+  if (segmentName.size() < 2 || !segmentName[-1].isSegment()) {
+    return nullptr;
+  }
+
+  auto versionedName = segmentName.getPrefix(-1);
+  auto segNum = segmentName[-1].toSegment();
+  auto isSegmentOf = [&versionedName] (const SegmentedLsa& cached) {
+    return !cached.segments.empty() &&
+           cached.segments.front()->getName().getPrefix(-1) == versionedName;
+  };
+
+  for (const auto& [type, cached] : m_segmentedLsas) {
+    if (isSegmentOf(cached)) {
+      return segNum < cached.segments.size() ? cached.segments[segNum] : nullptr;
+    }
+  }
+  for (const auto& [baseSeqNo, cached] : m_segmentedNameLsaDeltas) {
+    if (isSegmentOf(cached)) {
+      return segNum < cached.segments.size() ? cached.segments[segNum] : nullptr;
+    }
+  }
+  return nullptr;
+}
+
 void
 Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 {
@@ -272,10 +442,17 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
   // Else this is a known name LSA, so we are updating it.
   else if (chkLsa->getSeqNo() < lsa->getSeqNo()) {
     NLSR_LOG_DEBUG("Updating LSA:\n" << *chkLsa);
+    if (lsa->getOriginRouter() == m_thisRouterPrefix) {
+      // Segments of the previous version are no longer served
+      m_segmentedLsas.erase(lsa->getType());
+    }
     chkLsa->setSeqNo(lsa->getSeqNo());
     chkLsa->setExpirationTimePoint(lsa->getExpirationTimePoint());
 
     auto [updated, namesToAdd, namesToRemove] = chkLsa->update(lsa);
+    if (lsa->getOriginRouter() == m_thisRouterPrefix && lsa->getType() == Lsa::Type::NAME) {
+      recordNameLsaChange(lsa->getSeqNo(), namesToAdd, namesToRemove);
+    }
     if (updated) {
       onLsdbModified(lsa, LsdbUpdate::UPDATED, namesToAdd, namesToRemove);
     }
@@ -291,7 +468,15 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
   if (lsaIt != m_lsdb.end()) {
     auto lsaPtr = *lsaIt;
     NLSR_LOG_DEBUG("Removing LSA:\n" << *lsaPtr);
+    if (lsaPtr->getOriginRouter() == m_thisRouterPrefix) {
+      m_segmentedLsas.erase(lsaPtr->getType());
+    }
     m_lsdb.erase(lsaIt);
+    // Reclaim the seq no of the removed LSA, unless a newer one is being fetched
+    auto highestSeqNo = m_highestSeqNo.find(lsaPtr->getOriginRouter(), lsaPtr->getType());
+    if (highestSeqNo && *highestSeqNo <= lsaPtr->getSeqNo()) {
+      m_highestSeqNo.erase(lsaPtr->getOriginRouter(), lsaPtr->getType());
+    }
     onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {});
   }
 }
@@ -361,11 +546,11 @@ Lsdb::buildAndInstallOwnAdjLsa()
   installLsa(std::make_shared<AdjLsa>(adjLsa));
 }
 
-ndn::scheduler::EventId
+util::TimerWheel::EventId
 Lsdb::scheduleLsaExpiration(std::shared_ptr<Lsa> lsa, ndn::time::seconds expTime)
 {
   NLSR_LOG_DEBUG("Scheduling expiration in: " << expTime + GRACE_PERIOD << " for " << lsa->getOriginRouter());
-  return m_scheduler.schedule(expTime + GRACE_PERIOD, [this, lsa] { expireOrRefreshLsa(lsa); });
+  return m_timerWheel.schedule(expTime + GRACE_PERIOD, [this, lsa] { expireOrRefreshLsa(lsa); });
 }
 
 void
@@ -389,6 +574,9 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
         lsaPtr->setSeqNo(lsaPtr->getSeqNo() + 1);
         m_sequencingManager.setLsaSeq(lsaPtr->getSeqNo(), lsaPtr->getType());
         lsaPtr->setExpirationTimePoint(getLsaExpirationTimePoint());
+        if (lsaPtr->getType() == Lsa::Type::NAME) {
+          recordNameLsaChange(lsaPtr->getSeqNo(), {}, {});
+        }
         NLSR_LOG_DEBUG("Updated LSA:\n" << *lsaPtr);
         // schedule refreshing event again
         lsaPtr->setExpiringEventId(scheduleLsaExpiration(lsaPtr, m_lsaRefreshTime));
@@ -408,9 +596,6 @@ void
 Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                       ndn::time::steady_clock::time_point deadline)
 {
-  // increment SENT_LSA_INTEREST
-  lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
-
   if (deadline == DEFAULT_LSA_RETRIEVAL_DEADLINE) {
     deadline = ndn::time::steady_clock::now() + ndn::time::seconds(static_cast<int>(LSA_REFRESH_TIME_MAX));
   }
@@ -419,31 +604,112 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
   // The seq no is the last
   uint64_t seqNo = interestName[-1].toNumber();
 
-  // If the LSA is not found in the list currently.
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
+  // Unless a higher seq no is known, in which case this is an old/invalid LSA
+  auto key = parseLsaName(lsaName);
+  const auto& [originRouter, lsaType] = key;
+  if (!m_highestSeqNo.insert(originRouter, lsaType, seqNo)) {
+    return;
   }
-  // If the new seq no is higher, that means the LSA is valid
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
+
+  // At most one fetch per LSA is in progress or waiting
+  if (auto fetchIt = m_fetchers.find(key); fetchIt != m_fetchers.end()) {
+    if (fetchIt->second.seqNo >= seqNo) {
+      NLSR_LOG_DEBUG("Already fetching " << lsaName << " Seq number: " << fetchIt->second.seqNo);
+      lsaIncrementSignal(Statistics::PacketType::LSA_FETCH_COALESCED);
+      return;
+    }
+    NLSR_LOG_DEBUG("Seq number " << seqNo << " supersedes fetch of " << lsaName <<
+                   " Seq number: " << fetchIt->second.seqNo);
+    fetchIt->second.fetcher->stop();
+    m_fetchers.erase(fetchIt);
+    lsaIncrementSignal(Statistics::PacketType::LSA_FETCH_SUPERSEDED);
   }
-  // Otherwise, its an old/invalid LSA
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  else if (auto pendingIt = m_pendingFetches.find(key); pendingIt != m_pendingFetches.end()) {
+    uint64_t pendingSeqNo = pendingIt->second.interestName[-1].toNumber();
+    if (pendingSeqNo >= seqNo) {
+      NLSR_LOG_DEBUG("Already waiting to fetch " << lsaName << " Seq number: " << pendingSeqNo);
+      lsaIncrementSignal(Statistics::PacketType::LSA_FETCH_COALESCED);
+      return;
+    }
+    // Take the place of the older seq no in the queue
+    pendingIt->second = PendingLsaFetch{interestName, timeoutCount, incomingFaceId, deadline};
+    lsaIncrementSignal(Statistics::PacketType::LSA_FETCH_SUPERSEDED);
     return;
   }
 
-  ndn::Interest interest(interestName);
-  if (incomingFaceId != 0) {
-    interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(incomingFaceId));
+  m_pendingFetches.emplace(key, PendingLsaFetch{interestName, timeoutCount, incomingFaceId,
+                                                deadline});
+  // The topology is needed before name prefixes are of any use
+  if (lsaType == Lsa::Type::NAME) {
+    m_nameFetchQueue.push_back(key);
+  }
+  else {
+    m_topologyFetchQueue.push_back(key);
+  }
+  startPendingFetches();
+}
+
+void
+Lsdb::startPendingFetches()
+{
+  while (m_fetchers.size() < m_confParam.getMaxConcurrentLsaFetches()) {
+    auto& queue = m_topologyFetchQueue.empty() ? m_nameFetchQueue : m_topologyFetchQueue;
+    if (queue.empty()) {
+      break;
+    }
+    auto key = std::move(queue.front());
+    queue.pop_front();
+
+    auto pendingIt = m_pendingFetches.find(key);
+    auto pending = std::move(pendingIt->second);
+    m_pendingFetches.erase(pendingIt);
+    startFetch(key, pending);
+  }
+}
+
+void
+Lsdb::startFetch(const FetchKey& key, const PendingLsaFetch& pending)
+{
+  const auto& interestName = pending.interestName;
+  auto timeoutCount = pending.timeoutCount;
+  auto deadline = pending.deadline;
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  // Ask only for the changes since the version of the Name LSA that is installed
+  ndn::Name fetchName = interestName;
+  if (std::get<Lsa::Type>(key) == Lsa::Type::NAME && m_confParam.isNameLsaDeltasEnabled() &&
+      m_fullNameLsaFetches.erase(key) == 0) {
+    auto nameLsa = findLsa(std::get<ndn::Name>(key), Lsa::Type::NAME);
+    if (nameLsa != nullptr && nameLsa->getSeqNo() < seqNo) {
+      fetchName.append(NAME_LSA_DELTA_COMPONENT).appendNumber(nameLsa->getSeqNo());
+    }
+  }
+
+  // increment SENT_LSA_INTEREST
+  lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
+
+  ndn::Interest interest(fetchName);
+  if (pending.incomingFaceId != 0) {
+    interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(pending.incomingFaceId));
   }
   ndn::SegmentFetcher::Options options;
   options.interestLifetime = m_confParam.getLsaInterestLifetime();
   options.maxTimeout = m_confParam.getLsaInterestLifetime();
 
-  NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << seqNo);
+  NLSR_LOG_DEBUG("Fetching Data for LSA: " << fetchName << " Seq number: " << seqNo);
   auto fetcher = ndn::SegmentFetcher::start(m_face, interest, m_confParam.getValidator(), options);
 
-  auto it = m_fetchers.insert(fetcher).first;
+  m_fetchers[key] = LsaFetch{seqNo, fetcher};
+  // Forget the fetch when it ends, unless a newer one has superseded it, and let the next
+  // waiting fetch start
+  auto finishFetch = [this, key, fetcher = fetcher.get()] {
+    auto fetchIt = m_fetchers.find(key);
+    if (fetchIt != m_fetchers.end() && fetchIt->second.fetcher.get() == fetcher) {
+      m_fetchers.erase(fetchIt);
+      startPendingFetches();
+    }
+  };
 
   fetcher->afterSegmentValidated.connect([this] (const ndn::Data& data) {
     // Nlsr class subscribes to this to fetch certificates
@@ -453,24 +719,38 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
     auto lsaSegment = std::make_shared<const ndn::Data>(data);
     m_lsaStorage.insert(*lsaSegment);
     // Schedule deletion of the segment
-    m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
-                         [this, name = lsaSegment->getName()] { m_lsaStorage.erase(name); });
+    m_timerWheel.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
+                          [this, name = lsaSegment->getName()] { m_lsaStorage.erase(name); });
   });
 
   fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
     m_lsaStorage.erase(ndn::Name(lsaName).appendNumber(seqNo - 1));
+    // Before the LSA is processed, so that a delta that cannot be applied can be fetched again
+    finishFetch();
     afterFetchLsa(bufferPtr, interestName);
-    m_fetchers.erase(it);
   });
 
   fetcher->onError.connect([=] (uint32_t errorCode, const std::string& msg) {
+    // The origin might not serve deltas; retry with the whole LSA
+    if (fetchName != interestName) {
+      m_fullNameLsaFetches.insert(key);
+    }
     onFetchLsaError(errorCode, msg, interestName, timeoutCount, deadline, lsaName, seqNo);
-    m_fetchers.erase(it);
+    finishFetch();
   });
 
-  Lsa::Type lsaType;
-  std::istringstream(interestName[-2].toUri()) >> lsaType;
-  incrementInterestSentStats(lsaType);
+  incrementInterestSentStats(std::get<Lsa::Type>(key));
+}
+
+ndn::time::milliseconds
+Lsdb::getLsaFetchRetryDelay(uint32_t retransmitNo)
+{
+  auto backoff = std::min(LSA_FETCH_RETRY_INITIAL_DELAY * (1 << std::min(retransmitNo, 16U)),
+                          LSA_FETCH_RETRY_MAX_DELAY);
+  // Jitter, so that the retries of many LSAs that failed together do not line up
+  std::uniform_int_distribution<ndn::time::milliseconds::rep> dist(backoff.count() / 2,
+                                                                   backoff.count());
+  return ndn::time::milliseconds(dist(ndn::random::getRandomNumberEngine()));
 }
 
 void
@@ -481,21 +761,36 @@ Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Nam
   NLSR_LOG_DEBUG("Failed to fetch LSA: " << lsaName << ", Error code: " << errorCode
                  << ", Message: " << msg);
 
+  auto [originRouter, lsaType] = parseLsaName(lsaName);
+  auto highestSeqNo = m_highestSeqNo.find(originRouter, lsaType);
   if (ndn::time::steady_clock::now() < deadline) {
-    auto it = m_highestSeqNo.find(lsaName);
-    if (it != m_highestSeqNo.end() && it->second == seqNo) {
-      // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
-      // immediately since at the least the LSA Interest lifetime has elapsed.
-      // Otherwise, it is necessary to delay the Interest re-expression to prevent
-      // the potential for constant Interest flooding.
-      auto delay = m_confParam.getLsaInterestLifetime();
-      if (errorCode == ndn::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
-        delay = 0_s;
-      }
+    if (highestSeqNo == seqNo) {
+      // Back off exponentially to prevent the potential for constant Interest flooding
+      auto delay = getLsaFetchRetryDelay(retransmitNo);
       m_scheduler.schedule(delay, std::bind(&Lsdb::expressInterest, this, interestName,
                                             retransmitNo + 1, /*Multicast FaceID*/0, deadline));
     }
   }
+  // Giving up on an LSA that was never installed; forget it unless a newer one is on its way
+  else if (highestSeqNo == seqNo && findLsa(originRouter, lsaType) == nullptr) {
+    m_highestSeqNo.erase(originRouter, lsaType);
+  }
+}
+
+std::tuple<ndn::Name, Lsa::Type>
+Lsdb::parseLsaName(const ndn::Name& lsaName) const
+{
+  Lsa::Type lsaType;
+  std::istringstream(lsaName[-1].toUri()) >> lsaType;
+
+  int32_t lsaPosition = util::getNameComponentPosition(lsaName, "LSA");
+  if (lsaPosition < 0) {
+    // Not an LSA name, but it still identifies the LSA
+    return {lsaName.getPrefix(-1), lsaType};
+  }
+  ndn::Name originRouter = m_confParam.getNetwork();
+  originRouter.append(lsaName.getSubName(lsaPosition + 1, lsaName.size() - lsaPosition - 2));
+  return {originRouter, lsaType};
 }
 
 void
@@ -507,14 +802,8 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
   uint64_t seqNo = interestName[-1].toNumber();
 
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-    NLSR_LOG_TRACE("SeqNo for LSA(name): " << interestName << " updated");
-  }
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  auto [originRouter, lsaType] = parseLsaName(lsaName);
+  if (!m_highestSeqNo.insert(originRouter, lsaType, seqNo)) {
     return;
   }
 
@@ -522,35 +811,50 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
 
   if (lsaPosition >= 0) {
-    // Extracts the prefix of the originating router from the data.
-    ndn::Name originRouter = m_confParam.getNetwork();
-    originRouter.append(interestName.getSubName(lsaPosition + 1,
-                                                interestName.size() - lsaPosition - 3));
     try {
-      Lsa::Type interestedLsType;
-      std::istringstream(interestName[-2].toUri()) >> interestedLsType;
-
-      if (interestedLsType == Lsa::Type::BASE) {
+      if (lsaType == Lsa::Type::BASE) {
         NLSR_LOG_WARN("Received unrecognized LSA Type: " << interestName[-2].toUri());
         return;
       }
 
       ndn::Block block(bufferPtr);
-      if (interestedLsType == Lsa::Type::NAME) {
+      if (lsaType == Lsa::Type::NAME) {
         lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
-          installLsa(std::make_shared<NameLsa>(block));
+        if (isLsaNew(originRouter, lsaType, seqNo)) {
+          std::shared_ptr<NameLsa> nameLsa;
+          if (block.type() == tlv::NameLsaNoDelta) {
+            NLSR_LOG_DEBUG("No Name LSA delta from the installed LSA, fetching the whole LSA");
+          }
+          else {
+            nameLsa = std::make_shared<NameLsa>(block);
+            if (nameLsa->isDelta()) {
+              lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_DELTA);
+              auto baseLsa = findLsa(originRouter, lsaType);
+              if (baseLsa == nullptr || baseLsa->getSeqNo() != *nameLsa->getBaseSeqNo()) {
+                NLSR_LOG_DEBUG("Name LSA delta from " << *nameLsa->getBaseSeqNo() <<
+                               " does not apply to the installed LSA, fetching the whole LSA");
+                nameLsa = nullptr;
+              }
+            }
+          }
+
+          if (nameLsa == nullptr) {
+            m_fullNameLsaFetches.emplace(originRouter, lsaType);
+            expressInterest(interestName, 0, 0);
+            return;
+          }
+          installLsa(nameLsa);
         }
       }
-      else if (interestedLsType == Lsa::Type::ADJACENCY) {
+      else if (lsaType == Lsa::Type::ADJACENCY) {
         lsaIncrementSignal(Statistics::PacketType::RCV_ADJ_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
+        if (isLsaNew(originRouter, lsaType, seqNo)) {
           installLsa(std::make_shared<AdjLsa>(block));
         }
       }
-      else if (interestedLsType == Lsa::Type::COORDINATE) {
+      else if (lsaType == Lsa::Type::COORDINATE) {
         lsaIncrementSignal(Statistics::PacketType::RCV_COORD_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
+        if (isLsaNew(originRouter, lsaType, seqNo)) {
           installLsa(std::make_shared<CoordinateLsa>(block));
         }
       }
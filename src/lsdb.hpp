@@ -24,6 +24,7 @@
 
 #include "communication/sync-logic-handler.hpp"
 #include "conf-parameter.hpp"
+#include "highest-seq-no-table.hpp"
 #include "lsa/lsa.hpp"
 #include "lsa/name-lsa.hpp"
 #include "lsa/coordinate-lsa.hpp"
@@ -42,8 +43,8 @@
 #include "route/routing-calculator-hybrid-service.hpp"
 #include "route/routing-calculator-hybrid-weighted-service.hpp"
 #include "route/routing-calculator-hybrid-weighted-service-hybrid.hpp"
+#include "utility/timer-wheel.hpp"
 
-#include <ndn-cxx/ims/in-memory-storage-fifo.hpp>
 #include <ndn-cxx/ims/in-memory-storage-persistent.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/util/segmenter.hpp>
@@ -52,10 +53,13 @@
 #include <ndn-cxx/util/time.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 
+#include <deque>
+#include <optional>
+#include <set>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_array.hpp>
 
 namespace nlsr {
 
@@ -69,8 +73,6 @@ enum class LsdbUpdate {
   REMOVED
 };
 
-using AdjMatrix = boost::multi_array<double, 2>;
-
 class Lsdb
 {
 public:
@@ -98,6 +100,14 @@ public:
   void
   buildAndInstallOwnNameLsa();
 
+  /*! \brief Schedules a build of this router's Name LSA.
+
+    Prefixes that are advertised or withdrawn within the Name LSA build interval are
+    originated together, in one Name LSA.
+   */
+  void
+  scheduleNameLsaBuild();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /*! \brief Builds a cor. LSA for this router and installs it into the LSDB. */
   void
@@ -116,6 +126,8 @@ public:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>
    * 2) Interest containing segment number:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>/<version>/<segmentNo>
+   * Either can ask for the delta of a Name LSA from an earlier version, baseSeqNo:
+   *    /localhop/<network>/nlsr/LSA/<site>/<router>/NAME/<seqNo>/delta/<baseSeqNo>
   */
   void
   processInterest(const ndn::Name& name, const ndn::Interest& interest);
@@ -290,11 +302,11 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   buildAndInstallOwnAdjLsa();
 
-  /*! \brief Schedules a refresh/expire event in the scheduler.
+  /*! \brief Schedules a refresh/expire event in the timer wheel.
     \param lsa The LSA.
     \param expTime How many seconds to wait before triggering the event.
    */
-  ndn::scheduler::EventId
+  util::TimerWheel::EventId
   scheduleLsaExpiration(std::shared_ptr<Lsa> lsa, ndn::time::seconds expTime);
 
   /*! \brief Either allow to expire, or refresh a name LSA.
@@ -305,8 +317,57 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   bool
   processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
-                        Lsa::Type lsaType, uint64_t seqNo);
+                        Lsa::Type lsaType, uint64_t seqNo,
+                        std::optional<uint64_t> baseSeqNo = std::nullopt);
+
+  /*! \brief Returns the signed segments of one of this router's LSAs.
+    \param lsa The LSA.
+
+    The segments of each LSA version are signed once under the name of the
+    LSA, and served from m_segmentedLsas by LSA type and sequence number until
+    the LSA changes.
+   */
+  const std::vector<std::shared_ptr<ndn::Data>>&
+  getSignedSegments(const Lsa& lsa);
+
+  /*! \brief Finds a segment of this router's LSAs by its full name.
+    \return The segment, or nullptr if it is not cached.
+   */
+  std::shared_ptr<const ndn::Data>
+  findSignedSegment(const ndn::Name& segmentName) const;
 
+  /*! \brief Returns the signed segments of the delta of this router's Name LSA from
+    version baseSeqNo.
+    \param baseSeqNo Version of the Name LSA that the receiver has.
+    \param lsaName Name of the delta without version and segment number.
+
+    If no delta can be built, the only segment contains an empty NameLsaNoDelta element,
+    which tells the receiver to fetch the whole LSA under its plain name.
+   */
+  const std::vector<std::shared_ptr<ndn::Data>>&
+  getSignedNameLsaDeltaSegments(uint64_t baseSeqNo, const ndn::Name& lsaName);
+
+  /*! \brief Builds the delta of this router's Name LSA from version baseSeqNo.
+    \return The delta, or nullptr if the changes since baseSeqNo are no longer known, or
+            if they are not smaller than the Name LSA.
+   */
+  std::shared_ptr<NameLsa>
+  buildNameLsaDelta(uint64_t baseSeqNo) const;
+
+  /*! \brief Remembers the prefixes added and removed by a version of this router's
+    Name LSA, so that deltas can be built from the versions before it.
+   */
+  void
+  recordNameLsaChange(uint64_t seqNo, const std::vector<PrefixInfo>& added,
+                      const std::vector<PrefixInfo>& removed);
+
+  /*! \brief Fetches an LSA announced by sync.
+
+    Fetches wait in a queue until one of the concurrent fetch slots is free; Adjacency and
+    Coordinate LSAs are fetched before Name LSAs. A request for an LSA that is already being
+    fetched, or waiting, joins that fetch, unless its seq no is newer, in which case it
+    replaces it.
+   */
   void
   expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                   ndn::time::steady_clock::time_point deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
@@ -340,6 +401,21 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName);
 
+  /*! \brief Returns the delay before the next attempt to fetch an LSA.
+    \param retransmitNo Number of attempts that have failed so far, minus one.
+
+    The delay doubles with each attempt, up to a maximum, and is jittered.
+   */
+  static ndn::time::milliseconds
+  getLsaFetchRetryDelay(uint32_t retransmitNo);
+
+  /*! \brief Extracts the origin router and the type of an LSA from its name.
+    \param lsaName Name of the LSA without sequence number, in the format:
+           /<network>/NLSR/LSA/<site>/%C1.Router/<router>/<lsa-type>
+   */
+  std::tuple<ndn::Name, Lsa::Type>
+  parseLsaName(const ndn::Name& lsaName) const;
+
   void
   emitSegmentValidatedSignal(const ndn::Data& data)
   {
@@ -354,14 +430,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 public:
   ndn::signal::Signal<Lsdb, Statistics::PacketType> lsaIncrementSignal;
+  /// Emitted with the number of segments each time an LSA is signed
+  ndn::signal::Signal<Lsdb, size_t> afterSegmentsSigned;
   ndn::signal::Signal<Lsdb, ndn::Data> afterSegmentValidatedSignal;
   using AfterLsdbModified = ndn::signal::Signal<Lsdb, std::shared_ptr<Lsa>, LsdbUpdate,
-                                                std::list<nlsr::PrefixInfo>, std::list<nlsr::PrefixInfo>>;
+                                                std::vector<nlsr::PrefixInfo>,
+                                                std::vector<nlsr::PrefixInfo>>;
   AfterLsdbModified onLsdbModified;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::Face& m_face;
   ndn::Scheduler m_scheduler;
+  /// Expirations of LSAs and evictions of LSA segments, which need only second granularity
+  util::TimerWheel m_timerWheel;
   ConfParameter& m_confParam;
 
   SyncLogicHandler m_sync;
@@ -372,30 +453,97 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::time::seconds m_adjLsaBuildInterval;
   const ndn::Name& m_thisRouterPrefix;
 
-  // Maps the name of an LSA to its highest known sequence number from sync;
+  // Highest known sequence number from sync of each LSA of other routers;
   // Used to stop NLSR from trying to fetch outdated LSAs
-  std::map<ndn::Name, uint64_t> m_highestSeqNo;
+  HighestSeqNoTable m_highestSeqNo;
 
   SequencingManager m_sequencingManager;
 
   ndn::signal::ScopedConnection m_onNewLsaConnection;
 
-  std::set<std::shared_ptr<ndn::SegmentFetcher>> m_fetchers;
+  using FetchKey = std::tuple<ndn::Name, Lsa::Type>;
+
+  /*! \brief A fetch of an LSA of another router that is in progress. */
+  struct LsaFetch
+  {
+    uint64_t seqNo;
+    std::shared_ptr<ndn::SegmentFetcher> fetcher;
+  };
+  /// Fetches in progress, at most one per LSA; a newer seq no supersedes an older fetch
+  std::map<FetchKey, LsaFetch> m_fetchers;
+
+  /*! \brief A fetch waiting for a free slot. */
+  struct PendingLsaFetch
+  {
+    ndn::Name interestName;
+    uint32_t timeoutCount;
+    uint64_t incomingFaceId;
+    ndn::time::steady_clock::time_point deadline;
+  };
+  std::map<FetchKey, PendingLsaFetch> m_pendingFetches;
+  /// Order in which pending Adjacency and Coordinate LSA fetches start
+  std::deque<FetchKey> m_topologyFetchQueue;
+  /// Order in which pending Name LSA fetches start, once no topology fetch is waiting
+  std::deque<FetchKey> m_nameFetchQueue;
+  /// Name LSAs whose next fetch asks for the whole LSA, because a delta could not be used
+  std::set<FetchKey> m_fullNameLsaFetches;
+
+  /*! \brief Starts waiting fetches while fewer than the configured number are in progress. */
+  void
+  startPendingFetches();
+
+  void
+  startFetch(const FetchKey& key, const PendingLsaFetch& pending);
+
   ndn::Segmenter m_segmenter;
-  ndn::InMemoryStorageFifo m_segmentFifo;
+
+  /*! \brief Signed segments of a version of one of this router's LSAs. */
+  struct SegmentedLsa
+  {
+    /// Name of the LSA without version and segment number; it includes the sequence number
+    ndn::Name name;
+    /// Sequence number of the LSA version that was segmented
+    uint64_t seqNo = 0;
+    std::vector<std::shared_ptr<ndn::Data>> segments;
+  };
+  /// Latest signed segments of each type of LSA of this router, valid for their seq no
+  std::map<Lsa::Type, SegmentedLsa> m_segmentedLsas;
+  /// Signed segments of deltas of the latest Name LSA of this router, by base seq no
+  std::map<uint64_t, SegmentedLsa> m_segmentedNameLsaDeltas;
+
+  /*! \brief Prefixes added and removed by a version of this router's Name LSA. */
+  struct NameLsaChange
+  {
+    uint64_t seqNo;
+    NamePrefixList added;
+    NamePrefixList removed;
+  };
+  /// Changes of the latest versions of this router's Name LSA, with consecutive seq nos
+  std::deque<NameLsaChange> m_nameLsaChanges;
+
+  void
+  signSegments(SegmentedLsa& cached, const ndn::Name& lsaName, const ndn::Block& lsaWire);
 
   bool m_isBuildAdjLsaScheduled;
   int64_t m_adjBuildCount;
   ndn::scheduler::ScopedEventId m_scheduledAdjLsaBuild;
+  bool m_isBuildNameLsaScheduled;
+  ndn::scheduler::ScopedEventId m_scheduledNameLsaBuild;
 
   ndn::InMemoryStoragePersistent m_lsaStorage;
 
   static inline const ndn::time::steady_clock::time_point DEFAULT_LSA_RETRIEVAL_DEADLINE =
     ndn::time::steady_clock::time_point::min();
+  static constexpr ndn::time::milliseconds LSA_FETCH_RETRY_INITIAL_DELAY{500};
+  static constexpr ndn::time::milliseconds LSA_FETCH_RETRY_MAX_DELAY{60000};
+  /// Number of versions of this router's Name LSA that deltas can be built from
+  static constexpr size_t NAME_LSA_CHANGES_MAX = 16;
+  /// Number of bases whose signed delta replies are kept
+  static constexpr size_t NAME_LSA_DELTA_CACHE_MAX = 2 * NAME_LSA_CHANGES_MAX;
+  static inline const ndn::name::Component NAME_LSA_DELTA_COMPONENT{"delta"};
 
   std::shared_ptr<RoutingTable> m_routingTable;
   std::shared_ptr<RoutingCalculator> m_routingCalculator;
-  AdjMatrix m_adjMatrix;
   ndn::time::seconds m_lsaExpirationTime;
 };
 
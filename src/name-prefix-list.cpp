@@ -65,6 +65,12 @@ NamePrefixList::erase(const ndn::Name& name, const std::string& source)
   return isRemoved;
 }
 
+bool
+NamePrefixList::remove(const ndn::Name& name)
+{
+  return m_namesSources.erase(name) > 0;
+}
+
 const PrefixInfo&
 NamePrefixList::getPrefixInfoForName(const ndn::Name& name) const
 {
@@ -93,6 +99,18 @@ NamePrefixList::getPrefixInfo() const
   return nameCosts;
 }
 
+std::vector<const PrefixInfo*>
+NamePrefixList::getSortedView() const
+{
+  // The map is ordered by name, so the view is sorted as it is filled
+  std::vector<const PrefixInfo*> view;
+  view.reserve(m_namesSources.size());
+  for (const auto& [name, soucePrefixInfo] : m_namesSources) {
+    view.push_back(&soucePrefixInfo.costObj);
+  }
+  return view;
+}
+
 #ifdef WITH_TESTS
 
 std::set<std::string>
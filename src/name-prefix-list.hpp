@@ -33,6 +33,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace nlsr {
 
@@ -124,12 +125,27 @@ public:
   bool
   erase(const ndn::Name& name, const std::string& source = "");
 
+  /*! \brief Deletes the name, whatever its sources are.
+      \retval true The name is deleted.
+      \retval false The name does not exist.
+   */
+  bool
+  remove(const ndn::Name& name);
+
   size_t
   size() const
   {
     return m_namesSources.size();
   }
 
+  /*! \brief Returns whether the name is in the list, from any source.
+   */
+  bool
+  contains(const ndn::Name& name) const
+  {
+    return m_namesSources.count(name) > 0;
+  }
+
   const PrefixInfo&
   getPrefixInfoForName(const ndn::Name& name) const;
 
@@ -139,6 +155,14 @@ public:
   std::list<PrefixInfo>
   getPrefixInfo() const;
 
+  /*! \brief Returns the names and their costs in a contiguous array, sorted by name.
+
+      The entries point into the list, and stay valid until it changes. Nothing is copied, so
+      two lists can be compared with one linear merge of their views.
+   */
+  std::vector<const PrefixInfo*>
+  getSortedView() const;
+
 #ifdef WITH_TESTS
   /*! Returns the sources that this name has.
       If the name does not exist, returns an empty container.
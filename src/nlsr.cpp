@@ -43,7 +43,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_namePrefixList(confParam.getNamePrefixList())
   , m_fib(m_face, m_scheduler, m_adjacencyList, m_confParam, keyChain)
   , m_lsdb(m_face, keyChain, m_confParam)
-  , m_routingTable(m_scheduler, m_lsdb, m_confParam)
+  , m_routingTable(m_scheduler, m_face.getIoContext(), m_lsdb, m_confParam)
   , m_namePrefixTable(confParam.getRouterPrefix(), m_fib, m_routingTable,
                       m_routingTable.afterRoutingChange, m_lsdb.onLsdbModified)
   , m_helloProtocol(m_face, keyChain, confParam, m_routingTable, m_lsdb)
@@ -76,7 +76,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_nfdRibCommandProcessor(m_dispatcher,
       m_namePrefixList,
       m_lsdb)
-  , m_statsCollector(m_lsdb, m_helloProtocol)
+  , m_statsCollector(m_lsdb, m_helloProtocol, m_routingTable)
   , m_faceMonitor(m_face)
   , m_terminateSignals(face.getIoContext(), SIGINT, SIGTERM)
 {
@@ -213,6 +213,9 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
           // has met the HELLO retry threshold
           adjacent->setInterestTimedOutNo(m_confParam.getInterestRetryNumber());
 
+          // Stop forwarding through the neighbor until the routing table is recalculated
+          m_routingTable.switchToBackupNextHops(adjacent->getFaceUri());
+
           if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
             m_routingTable.scheduleRoutingTableCalculation();
           }
@@ -36,7 +36,7 @@ INIT_LOGGER(route.Fib);
 
 Fib::Fib(ndn::Face& face, ndn::Scheduler& scheduler, AdjacencyList& adjacencyList,
          ConfParameter& conf, ndn::security::KeyChain& keyChain)
-  : m_scheduler(scheduler)
+  : m_timerWheel(scheduler)
   , m_refreshTime(2 * conf.getLsaRefreshTime())
   , m_controller(face, keyChain)
   , m_adjacencyList(adjacencyList)
@@ -299,9 +299,9 @@ Fib::scheduleEntryRefresh(FibEntry& entry, const AfterRefreshCallback& refreshCa
                  " Seq Num: " << entry.seqNo <<
                  " in " << m_refreshTime << " seconds");
 
-  entry.refreshEventId = m_scheduler.schedule(ndn::time::seconds(m_refreshTime),
-                                              std::bind(&Fib::refreshEntry, this,
-                                                        entry.name, refreshCallback));
+  entry.refreshEventId = m_timerWheel.schedule(ndn::time::seconds(m_refreshTime),
+                                               std::bind(&Fib::refreshEntry, this,
+                                                         entry.name, refreshCallback));
 }
 
 void
@@ -24,6 +24,7 @@
 
 #include "test-access-control.hpp"
 #include "nexthop-list.hpp"
+#include "utility/timer-wheel.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
@@ -36,7 +37,7 @@ using NextHopsUriSortedSet = NexthopListT<NextHopUriSortedComparator>;
 struct FibEntry
 {
   ndn::Name name;
-  ndn::scheduler::ScopedEventId refreshEventId;
+  util::TimerWheel::ScopedEventId refreshEventId;
   int32_t seqNo = 1;
   NextHopsUriSortedSet nexthopSet;
 };
@@ -214,7 +215,8 @@ public:
   ndn::signal::Signal<Fib, ndn::Name> onPrefixRegistrationSuccess;
 
 private:
-  ndn::Scheduler& m_scheduler;
+  /// Refreshes of FIB entries, which need only second granularity
+  util::TimerWheel m_timerWheel;
   int32_t m_refreshTime;
   ndn::nfd::Controller m_controller;
 
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-snapshot.hpp"
+
+namespace nlsr {
+
+LsdbSnapshot::LsdbSnapshot(const Lsdb& lsdb, const AdjacencyList& adjacencies, bool isDetached)
+{
+  if (!isDetached) {
+    m_lsdb = &lsdb;
+    m_adjacencies = &adjacencies;
+    referLsas<AdjLsa>(lsdb);
+    referLsas<CoordinateLsa>(lsdb);
+    referLsas<NameLsa>(lsdb);
+    return;
+  }
+
+  m_adjacencyCopy = adjacencies;
+  copyLsas<AdjLsa>(lsdb);
+  copyLsas<CoordinateLsa>(lsdb);
+  copyLsas<NameLsa>(lsdb);
+}
+
+template<typename T>
+void
+LsdbSnapshot::copyLsas(const Lsdb& lsdb)
+{
+  auto& lsas = m_lsas[static_cast<size_t>(T::type())];
+  auto range = lsdb.getLsdbIterator<T>();
+  for (auto it = range.first; it != range.second; ++it) {
+    // *it has type std::shared_ptr<Lsa> ; copy the LSA so that later updates do not reach it
+    const auto& original = static_cast<const T&>(**it);
+    std::shared_ptr<const T> lsa;
+    if constexpr (std::is_same_v<T, NameLsa>) {
+      // The calculators only read the router metrics, so the prefixes are left out
+      lsa = std::make_shared<const NameLsa>(original.getOriginRouter(), original.getSeqNo(),
+                                            original.getExpirationTimePoint(), NamePrefixList(),
+                                            original.getProcessingTime(),
+                                            original.getLoadIndex());
+    }
+    else {
+      lsa = std::make_shared<const T>(original);
+    }
+    m_byName.emplace(std::make_tuple(lsa->getOriginRouter(), T::type()), lsa);
+    lsas.push_back(std::move(lsa));
+  }
+}
+
+template<typename T>
+void
+LsdbSnapshot::referLsas(const Lsdb& lsdb)
+{
+  auto& lsas = m_lsas[static_cast<size_t>(T::type())];
+  auto range = lsdb.getLsdbIterator<T>();
+  lsas.assign(range.first, range.second);
+}
+
+std::shared_ptr<const Lsa>
+LsdbSnapshot::findLsa(const ndn::Name& router, Lsa::Type lsaType) const
+{
+  auto it = m_byName.find(std::make_tuple(router, lsaType));
+  return it != m_byName.end() ? it->second : nullptr;
+}
+
+} // namespace nlsr
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_LSDB_SNAPSHOT_HPP
+#define NLSR_ROUTE_LSDB_SNAPSHOT_HPP
+
+#include "common.hpp"
+#include "adjacency-list.hpp"
+#include "lsdb.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <map>
+
+namespace nlsr {
+
+/**
+ * @brief The LSAs and adjacencies used by the routing calculation.
+ *
+ * The LSDB updates its LSAs in place, so a calculation that runs off the main thread cannot
+ * read them directly. A detached snapshot copies what the calculators read when it is
+ * created: the Adjacency and Coordinate LSAs, and the processing time and load index of each
+ * Name LSA without its prefixes. Otherwise the snapshot only refers to the LSDB, which is
+ * enough for a calculation that runs to completion on the main thread.
+ */
+class LsdbSnapshot : boost::noncopyable
+{
+public:
+  using LsaList = std::vector<std::shared_ptr<const Lsa>>;
+
+  /**
+   * @brief Take the LSAs in @p lsdb and the adjacencies of this router.
+   * @param lsdb LSDB to read.
+   * @param adjacencies Neighbors of this router, whose faces and statuses are used to
+   *                    install next hops.
+   * @param isDetached Whether to copy the data, so that later changes of @p lsdb and
+   *                   @p adjacencies do not reach the snapshot. If false, the snapshot must not
+   *                   be used after either of them changes.
+   */
+  LsdbSnapshot(const Lsdb& lsdb, const AdjacencyList& adjacencies, bool isDetached = true);
+
+  /**
+   * @brief Return the LSAs of type @c T , in the order of Lsdb::getLsdbIterator.
+   */
+  template<typename T>
+  std::pair<LsaList::const_iterator, LsaList::const_iterator>
+  getLsdbIterator() const
+  {
+    const auto& lsas = m_lsas[static_cast<size_t>(T::type())];
+    return {lsas.begin(), lsas.end()};
+  }
+
+  /**
+   * @brief Find the LSA of type @c T originated by @p router .
+   * @return The LSA, or nullptr if there is none.
+   */
+  template<typename T>
+  std::shared_ptr<const T>
+  findLsa(const ndn::Name& router) const
+  {
+    if (m_lsdb != nullptr) {
+      return m_lsdb->findLsa<T>(router);
+    }
+    return std::static_pointer_cast<const T>(findLsa(router, T::type()));
+  }
+
+  const AdjacencyList&
+  getAdjacencyList() const
+  {
+    return *m_adjacencies;
+  }
+
+private:
+  template<typename T>
+  void
+  copyLsas(const Lsdb& lsdb);
+
+  template<typename T>
+  void
+  referLsas(const Lsdb& lsdb);
+
+  std::shared_ptr<const Lsa>
+  findLsa(const ndn::Name& router, Lsa::Type lsaType) const;
+
+private:
+  /// LSAs of each type, indexed by Lsa::Type
+  std::array<LsaList, static_cast<size_t>(Lsa::Type::BASE)> m_lsas;
+  std::map<std::tuple<ndn::Name, Lsa::Type>, std::shared_ptr<const Lsa>> m_byName;
+  /// LSDB that lookups go to, or nullptr if the snapshot is detached
+  const Lsdb* m_lsdb = nullptr;
+  AdjacencyList m_adjacencyCopy;
+  const AdjacencyList* m_adjacencies = &m_adjacencyCopy;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_LSDB_SNAPSHOT_HPP
@@ -53,6 +53,20 @@ NameMap::getMappingNoByRouterName(const ndn::Name& rtrName) const
   return it->get<MappingNo>();
 }
 
+bool
+NameMap::hasSameRouters(const NameMap& other) const
+{
+  if (size() != other.size()) {
+    return false;
+  }
+  for (const auto& entry : other.m_bimap) {
+    if (!getMappingNoByRouterName(entry.get<ndn::Name>())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const NameMap& map)
 {
@@ -122,6 +122,12 @@ public:
     return m_bimap.size();
   }
 
+  /**
+   * @brief Determine whether @p other contains the same router names, regardless of numbering.
+   */
+  bool
+  hasSameRouters(const NameMap& other) const;
+
 private:
   struct MappingNo;
   boost::bimap<
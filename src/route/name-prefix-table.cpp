@@ -24,6 +24,7 @@
 #include "logger.hpp"
 #include "nlsr.hpp"
 #include "routing-table.hpp"
+#include "routing-table-diff.hpp"
 
 #include <algorithm>
 #include <list>
@@ -42,8 +43,8 @@ NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
   , m_routingTable(routingTable)
 {
   m_afterRoutingChangeConnection = afterRoutingChangeSignal.connect(
-    [this] (const std::list<RoutingTableEntry>& entries) {
-      updateWithNewRoute(entries);
+    [this] (const RoutingTableDiff& diff) {
+      updateWithNewRoute(diff);
     });
 
   m_afterLsdbModified = afterLsdbModifiedSignal.connect(
@@ -62,8 +63,8 @@ NamePrefixTable::~NamePrefixTable()
 
 void
 NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-                                const std::list<nlsr::PrefixInfo>& namesToAdd,
-                                const std::list<nlsr::PrefixInfo>& namesToRemove)
+                                const std::vector<nlsr::PrefixInfo>& namesToAdd,
+                                const std::vector<nlsr::PrefixInfo>& namesToRemove)
 {
   if (m_ownRouterName == lsa->getOriginRouter()) {
     return;
@@ -277,39 +278,36 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
 }
 
 void
-NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
+NamePrefixTable::updateWithNewRoute(const RoutingTableDiff& diff)
 {
-  NLSR_LOG_DEBUG("Updating table with newly calculated routes");
-
-  // Iterate over each pool entry we have
-  for (auto&& poolEntryPair : m_rtpool) {
-    auto&& poolEntry = poolEntryPair.second;
-    auto sourceEntry = std::find_if(entries.begin(), entries.end(),
-                                    [&poolEntry] (const RoutingTableEntry& entry) {
-                                      return poolEntry->getDestination() == entry.getDestination();
-                                    });
-    // If this pool entry has a corresponding entry in the routing table now
-    if (sourceEntry != entries.end()
-        && poolEntry->getNexthopList() != sourceEntry->getNexthopList()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
-      poolEntry->setNexthopList(sourceEntry->getNexthopList());
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
+  NLSR_LOG_DEBUG("Updating table with " << diff.size() << " changed routes");
+
+  for (const auto* changes : {&diff.added, &diff.changed, &diff.removed}) {
+    for (const auto& change : *changes) {
+      // Only destinations that some name prefix goes through have a pool entry
+      auto poolIt = m_rtpool.find(change.destination);
+      if (poolIt == m_rtpool.end()) {
+        continue;
       }
-    }
-    else if (sourceEntry == entries.end()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
-      poolEntry->getNexthopList().clear();
+      auto& poolEntry = poolIt->second;
+      if (poolEntry->getNexthopList() == change.newNexthops) {
+        NLSR_LOG_TRACE("No change in routing entry:" << poolEntry->getDestination()
+                       << ", no action necessary.");
+        continue;
+      }
+
+      if (change.newNexthops.size() > 0) {
+        NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
+      }
+      else {
+        NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
+      }
+      poolEntry->setNexthopList(change.newNexthops);
       for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
         auto nameEntryFullPtr = nameEntry.second.lock();
         addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
       }
     }
-    else {
-      NLSR_LOG_TRACE("No change in routing entry:" << poolEntry->getDestination()
-                 << ", no action necessary.");
-    }
   }
 }
 
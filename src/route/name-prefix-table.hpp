@@ -60,8 +60,8 @@ public:
    */
   void
   updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-                 const std::list<nlsr::PrefixInfo>& namesToAdd,
-                 const std::list<nlsr::PrefixInfo>& namesToRemove);
+                 const std::vector<nlsr::PrefixInfo>& namesToAdd,
+                 const std::vector<nlsr::PrefixInfo>& namesToRemove);
 
   /*! \brief Adds a destination to the specified name prefix.
     \param name The name prefix
@@ -93,16 +93,16 @@ public:
   void
   removeEntry(const ndn::Name& name, const ndn::Name& destRouter);
 
-  /*! \brief Updates all routing information in the NPT.
+  /*! \brief Updates the routing information in the NPT.
 
-    Takes in a list of entries that are assumed to be exhaustive, and
-    updates each pool entry with the next hop information contained in
-    the corresponding entry in entries. If no entry is found, it is
-    assumed that the destination for that pool entry is inaccessible,
-    and its next hop information is deleted.
+    Takes in the changes between the previous and the new routing
+    table, and updates the pool entry of each changed destination with
+    its new next hop information. A removed destination is assumed to
+    be inaccessible, and its next hop information is deleted. Pool
+    entries of destinations that did not change are not visited.
    */
   void
-  updateWithNewRoute(const std::list<RoutingTableEntry>& entries);
+  updateWithNewRoute(const RoutingTableDiff& diff);
 
   /*! \brief Adds a pool entry to the pool.
     \param rtpe The entry.
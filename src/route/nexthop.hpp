@@ -112,6 +112,19 @@ public:
     return m_isHyperbolic;
   }
 
+  /*! \brief Mark this next hop as a loop-free alternate, used only when a neighbor fails. */
+  void
+  setBackup(bool b)
+  {
+    m_isBackup = b;
+  }
+
+  bool
+  isBackup() const
+  {
+    return m_isBackup;
+  }
+
   template<ndn::encoding::Tag TAG>
   size_t
   wireEncode(ndn::EncodingImpl<TAG>& block) const;
@@ -145,6 +158,7 @@ private:
   ndn::FaceUri m_connectingFaceUri;
   double m_routeCost = 0.0;
   bool m_isHyperbolic = false;
+  bool m_isBackup = false;
 
   mutable ndn::Block m_wire;
 
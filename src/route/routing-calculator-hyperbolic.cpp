@@ -27,12 +27,140 @@
 #include "logger.hpp"
 #include "nlsr.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace nlsr {
 
 INIT_LOGGER(route.RoutingCalculatorHyperbolic);
 
+constexpr double UNKNOWN_DISTANCE = -1.0;
+
+/**
+ * @brief Cached Cartesian embeddings of all routers, in a structure-of-arrays layout.
+ *
+ * Component @c k of the unit vector of router @c j is stored at `k * nRouters + j`, so the
+ * distances from one router to all others are computed by loops over contiguous arrays that
+ * the compiler can vectorize.
+ */
+class HyperbolicEmbeddings
+{
+public:
+  HyperbolicEmbeddings(const NameMap& map, const LsdbSnapshot& lsdb);
+
+  /**
+   * @brief Compute the hyperbolic distance from router @p src to every router.
+   * @return Distances indexed by mapping number; @c UNKNOWN_DISTANCE where the distance
+   *         cannot be computed.
+   */
+  std::vector<double>
+  calculateDistances(int src) const;
+
+  /**
+   * @brief Compute the hyperbolic distance from router @p src to router @p dest .
+   * @return The distance, or @c UNKNOWN_DISTANCE if it cannot be computed.
+   */
+  double
+  calculateDistance(int src, int dest) const;
+
+private:
+  size_t m_nRouters;
+  size_t m_nComponents = 0;
+  /// Number of components of each router's unit vector; 0 if it has no valid coordinates
+  std::vector<size_t> m_dimension;
+  std::vector<double> m_components;
+  std::vector<double> m_coshRadius;
+  std::vector<double> m_sinhRadius;
+};
+
+HyperbolicEmbeddings::HyperbolicEmbeddings(const NameMap& map, const LsdbSnapshot& lsdb)
+  : m_nRouters(map.size())
+  , m_dimension(m_nRouters, 0)
+  , m_coshRadius(m_nRouters, 1.0)
+  , m_sinhRadius(m_nRouters, 0.0)
+{
+  std::vector<std::shared_ptr<const CoordinateLsa>> lsas(m_nRouters);
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    auto routerName = map.getRouterNameByMappingNo(static_cast<int32_t>(j));
+    if (routerName) {
+      lsas[j] = lsdb.findLsa<CoordinateLsa>(*routerName);
+    }
+    // A router must be away from the origin for its distances to be defined
+    if (lsas[j] != nullptr && lsas[j]->getRadius() > 0.0) {
+      m_nComponents = std::max(m_nComponents, lsas[j]->getUnitVector().size());
+    }
+  }
+
+  m_components.assign(m_nComponents * m_nRouters, 0.0);
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    if (lsas[j] == nullptr || lsas[j]->getRadius() <= 0.0) {
+      continue;
+    }
+    const auto& unitVector = lsas[j]->getUnitVector();
+    m_dimension[j] = unitVector.size();
+    for (size_t k = 0; k < unitVector.size(); ++k) {
+      m_components[k * m_nRouters + j] = unitVector[k];
+    }
+    m_coshRadius[j] = lsas[j]->getCoshRadius();
+    m_sinhRadius[j] = lsas[j]->getSinhRadius();
+  }
+}
+
+std::vector<double>
+HyperbolicEmbeddings::calculateDistances(int src) const
+{
+  std::vector<double> distances(m_nRouters, UNKNOWN_DISTANCE);
+  size_t dimension = m_dimension[src];
+  if (dimension == 0) {
+    return distances;
+  }
+
+  // cos(Δθ) is the inner product of the unit vectors; missing components are zero
+  std::vector<double> innerProduct(m_nRouters, 0.0);
+  for (size_t k = 0; k < dimension; ++k) {
+    const double srcComponent = m_components[k * m_nRouters + src];
+    const double* components = &m_components[k * m_nRouters];
+    for (size_t j = 0; j < m_nRouters; ++j) {
+      innerProduct[j] += srcComponent * components[j];
+    }
+  }
+
+  // cosh(d) = cosh(r_i) cosh(r_j) - sinh(r_i) sinh(r_j) cos(Δθ), with zeta = 1
+  const double srcCosh = m_coshRadius[src];
+  const double srcSinh = m_sinhRadius[src];
+  std::vector<double> coshDistance(m_nRouters);
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    coshDistance[j] = srcCosh * m_coshRadius[j] - srcSinh * m_sinhRadius[j] * innerProduct[j];
+  }
+
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    // Routers with the same angular coordinates have Δθ = 0, where distances are not defined
+    if (m_dimension[j] == dimension && innerProduct[j] < 1.0) {
+      distances[j] = std::acosh(coshDistance[j]);
+    }
+  }
+  return distances;
+}
+
+double
+HyperbolicEmbeddings::calculateDistance(int src, int dest) const
+{
+  size_t dimension = m_dimension[src];
+  if (dimension == 0 || m_dimension[dest] != dimension) {
+    return UNKNOWN_DISTANCE;
+  }
+
+  double innerProduct = 0.0;
+  for (size_t k = 0; k < dimension; ++k) {
+    innerProduct += m_components[k * m_nRouters + src] * m_components[k * m_nRouters + dest];
+  }
+  if (innerProduct >= 1.0) {
+    return UNKNOWN_DISTANCE;
+  }
+  return std::acosh(m_coshRadius[src] * m_coshRadius[dest] -
+                    m_sinhRadius[src] * m_sinhRadius[dest] * innerProduct);
+}
+
 class HyperbolicRoutingCalculator
 {
 public:
@@ -44,21 +172,13 @@ public:
   }
 
   void
-  calculatePath(NameMap& map, RoutingTable& rt, Lsdb& lsdb, AdjacencyList& adjacencies);
+  calculatePath(NameMap& map, RoutingTableStatus& rt, const LsdbSnapshot& lsdb,
+                HyperbolicCache* cache);
 
 private:
-  double
-  getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest);
-
   void
-  addNextHop(const ndn::Name& destinationRouter, const ndn::FaceUri& faceUri, double cost, RoutingTable& rt);
-
-  double
-  calculateHyperbolicDistance(double rI, double rJ, double deltaTheta);
-
-  double
-  calculateAngularDistance(std::vector<double> angleVectorI,
-                           std::vector<double> angleVectorJ);
+  addNextHop(const ndn::Name& destinationRouter, const ndn::FaceUri& faceUri, double cost,
+             RoutingTableStatus& rt);
 
 private:
   const size_t m_nRouters;
@@ -66,19 +186,34 @@ private:
   const ndn::Name m_thisRouterName;
 };
 
-constexpr double UNKNOWN_DISTANCE = -1.0;
-constexpr double UNKNOWN_RADIUS   = -1.0;
-
 void
-HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,
-                                           Lsdb& lsdb, AdjacencyList& adjacencies)
+HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTableStatus& rt,
+                                           const LsdbSnapshot& lsdb, HyperbolicCache* cache)
 {
   NLSR_LOG_TRACE("Calculating hyperbolic paths");
 
+  // Cached distances can be reused if they are numbered the same way
+  bool isSameRouters = cache != nullptr && cache->distances.size() == map.size() &&
+                       cache->map.hasSameRouters(map);
+  std::vector<int> changedRouters;
+  std::vector<bool> isChanged(m_nRouters, false);
+  if (isSameRouters) {
+    map = cache->map;
+    for (const auto& routerName : cache->changedCoordinateLsas) {
+      if (auto i = map.getMappingNoByRouterName(routerName)) {
+        changedRouters.push_back(*i);
+        isChanged[*i] = true;
+      }
+    }
+  }
+
   auto thisRouter = map.getMappingNoByRouterName(m_thisRouterName);
+  HyperbolicEmbeddings embeddings(map, lsdb);
+  std::vector<std::vector<double>> distancesFrom(m_nRouters);
+  size_t nReused = 0;
 
   // Iterate over directly connected neighbors
-  std::list<Adjacent> neighbors = adjacencies.getAdjList();
+  std::list<Adjacent> neighbors = lsdb.getAdjacencyList().getAdjList();
   for (auto adj = neighbors.begin(); adj != neighbors.end(); ++adj) {
 
     // Don't calculate nexthops using an inactive router
@@ -103,164 +238,51 @@ HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,
       continue;
     }
 
-    // Get hyperbolic distance from direct neighbor to every other router
+    // Get hyperbolic distance from direct neighbor to every other router. If the neighbor
+    // did not move, only the distances to routers that moved can differ.
+    auto& distances = distancesFrom[*src];
+    if (isSameRouters && !isChanged[*src] && !cache->distances[*src].empty()) {
+      distances = std::move(cache->distances[*src]);
+      for (int dest : changedRouters) {
+        distances[dest] = embeddings.calculateDistance(*src, dest);
+      }
+      ++nReused;
+    }
+    else {
+      distances = embeddings.calculateDistances(*src);
+    }
     for (int dest = 0; dest < static_cast<int>(m_nRouters); ++dest) {
       // Don't calculate nexthops to this router or from a router to itself
       if (thisRouter && dest != *thisRouter && dest != *src) {
 
         auto destRouterName = map.getRouterNameByMappingNo(dest);
         if (destRouterName) {
-          double distance = getHyperbolicDistance(lsdb, srcRouterName, *destRouterName);
-
           // Could not compute distance
-          if (distance == UNKNOWN_DISTANCE) {
+          if (distances[dest] == UNKNOWN_DISTANCE) {
             NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << srcRouterName
                            << " to " << *destRouterName);
             continue;
           }
-          addNextHop(*destRouterName, adj->getFaceUri(), distance, rt);
+          NLSR_LOG_TRACE("Distance from " << srcRouterName << " to " << *destRouterName
+                         << " is " << distances[dest]);
+          addNextHop(*destRouterName, adj->getFaceUri(), distances[dest], rt);
         }
       }
     }
   }
-}
-
-double
-HyperbolicRoutingCalculator::getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest)
-{
-  NLSR_LOG_TRACE("Calculating hyperbolic distance from " << src << " to " << dest);
-
-  double distance = UNKNOWN_DISTANCE;
-
-  auto srcLsa  = lsdb.findLsa<CoordinateLsa>(src);
-  auto destLsa = lsdb.findLsa<CoordinateLsa>(dest);
-
-  // Coordinate LSAs do not exist for these routers
-  if (srcLsa == nullptr || destLsa == nullptr) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  std::vector<double> srcTheta = srcLsa->getTheta();
-  std::vector<double> destTheta = destLsa->getTheta();
-
-  double srcRadius = srcLsa->getRadius();
-  double destRadius = destLsa->getRadius();
-
-  double diffTheta = calculateAngularDistance(srcTheta, destTheta);
-
-  if (srcRadius == UNKNOWN_RADIUS || destRadius == UNKNOWN_RADIUS ||
-      diffTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  // double r_i, double r_j, double delta_theta, double zeta = 1 (default)
-  distance = calculateHyperbolicDistance(srcRadius, destRadius, diffTheta);
-
-  NLSR_LOG_TRACE("Distance from " << src << " to " << dest << " is " << distance);
-
-  return distance;
-}
-
-double
-HyperbolicRoutingCalculator::calculateAngularDistance(std::vector<double> angleVectorI,
-                                                      std::vector<double> angleVectorJ)
-{
-  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
-
-  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
-
-  // Check if two vector lengths are the same
-  if (angleVectorI.size() != angleVectorJ.size()) {
-    NLSR_LOG_ERROR("Angle vector sizes do not match");
-    return UNKNOWN_DISTANCE;
-  }
-
-  // Check if all angles are within the [0, PI] and [0, 2PI] ranges
-  if (angleVectorI.size() > 1) {
-    for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-      if ((angleVectorI[k] > M_PI && angleVectorI[k] < 0.0) ||
-          (angleVectorJ[k] > M_PI && angleVectorJ[k] < 0.0)) {
-        NLSR_LOG_ERROR("Angle outside [0, PI]");
-        return UNKNOWN_DISTANCE;
-      }
-    }
-  }
 
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
-  }
-
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
+  if (cache != nullptr) {
+    NLSR_LOG_DEBUG("Hyperbolic distances reused for " << nReused << " neighbors, " <<
+                   changedRouters.size() << " routers moved");
+    cache->map = map;
+    cache->changedCoordinateLsas.clear();
+    cache->distances = std::move(distancesFrom);
   }
-
-  // deltaTheta = arccos(vectorI . vectorJ) -> do the inner product
-  double innerProduct = 0.0;
-
-  // Calculate x0 of the vectors
-  double x0i = std::cos(angleVectorI[0]);
-  double x0j = std::cos(angleVectorJ[0]);
-
-  // Calculate xn of the vectors
-  double xni = std::sin(angleVectorI[angleVectorI.size() - 1]);
-  double xnj = std::sin(angleVectorJ[angleVectorJ.size() - 1]);
-
-  // Do the aggregation of the (n-1) coordinates (if there is more than one angle)
-  // i.e contraction of all (n-1)-dimensional angular coordinates to one variable
-  for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-    xni *= std::sin(angleVectorI[k]);
-    xnj *= std::sin(angleVectorJ[k]);
-  }
-  innerProduct += (x0i * x0j) + (xni * xnj);
-
-  // If d > 1
-  if (angleVectorI.size() > 1) {
-    for (unsigned int m = 1; m < angleVectorI.size(); m++) {
-      // calculate euclidean coordinates given the angles and assuming R_sphere = 1
-      double xmi = std::cos(angleVectorI[m]);
-      double xmj = std::cos(angleVectorJ[m]);
-      for (unsigned int l = 0; l < m; l++) {
-        xmi *= std::sin(angleVectorI[l]);
-        xmj *= std::sin(angleVectorJ[l]);
-      }
-      innerProduct += xmi * xmj;
-    }
-  }
-
-  // ArcCos of the inner product gives the angular distance
-  // between two points on a d-dimensional sphere
-  return std::acos(innerProduct);
-}
-
-double
-HyperbolicRoutingCalculator::calculateHyperbolicDistance(double rI, double rJ,
-                                                         double deltaTheta)
-{
-  if (deltaTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
-  }
-
-  // Usually, we set zeta = 1 in all experiments
-  double zeta = 1;
-
-  if (deltaTheta <= 0.0 || rI <= 0.0 || rJ <= 0.0) {
-    NLSR_LOG_ERROR("Delta theta or rI or rJ is <= 0");
-    NLSR_LOG_ERROR("Please make sure that no two nodes have the exact same HR coordinates");
-    return UNKNOWN_DISTANCE;
-  }
-
-  double xij = (1. / zeta) * std::acosh(std::cosh(zeta*rI) * std::cosh(zeta*rJ) -
-               std::sinh(zeta*rI)*std::sinh(zeta*rJ)*std::cos(deltaTheta));
-  return xij;
 }
 
 void
 HyperbolicRoutingCalculator::addNextHop(const ndn::Name& dest, const ndn::FaceUri& faceUri,
-                                        double cost, RoutingTable& rt)
+                                        double cost, RoutingTableStatus& rt)
 {
   NextHop hop(faceUri, cost);
   hop.setHyperbolic(true);
@@ -276,12 +298,11 @@ HyperbolicRoutingCalculator::addNextHop(const ndn::Name& dest, const ndn::FaceUr
 }
 
 void
-calculateHyperbolicRoutingPath(NameMap& map, RoutingTable& rt, Lsdb& lsdb,
-                               AdjacencyList& adjacencies, ndn::Name thisRouterName,
-                               bool isDryRun)
+calculateHyperbolicRoutingPath(NameMap& map, RoutingTableStatus& rt, const LsdbSnapshot& lsdb,
+                               ndn::Name thisRouterName, bool isDryRun, HyperbolicCache* cache)
 {
   HyperbolicRoutingCalculator calculator(map.size(), isDryRun, thisRouterName);
-  calculator.calculatePath(map, rt, lsdb, adjacencies);
+  calculator.calculatePath(map, rt, lsdb, cache);
 }
 
 } // namespace nlsr
@@ -22,14 +22,20 @@
 #include "routing-calculator.hpp"
 #include "name-map.hpp"
 #include "nexthop.hpp"
+#include "shortest-path.hpp"
+#include "topology-graph.hpp"
 #include "adjacent.hpp"
 #include "logger.hpp"
 #include "nlsr.hpp"
 #include "lsa/name-lsa.hpp"
 #include "conf-parameter.hpp"
 
-#include <boost/multi_array.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
 #include <cstdint>
+#include <future>
+#include <iterator>
 #include <string>
 #include <vector>
 #include <memory>
@@ -40,285 +46,194 @@ namespace {
 
 INIT_LOGGER(route.RoutingCalculatorLinkState);
 
-constexpr int EMPTY_PARENT = -12345;
-constexpr double INF_DISTANCE = 2147483647;
-constexpr int NO_NEXT_HOP = -12345;
-
 /**
- * @brief Adjacency matrix.
- *
- * The matrix shall be a 2D array with N rows and N columns, where N is the number of routers.
- * Element i,j is the cost from router i to router j.
+ * @brief List neighbors of a source router that are reachable over a usable link.
  */
-using AdjMatrix = boost::multi_array<double, 2>;
-
-struct PrintAdjMatrix
+std::vector<int>
+gatherNeighbors(const TopologyGraph& graph, int sourceRouter)
 {
-  const AdjMatrix& matrix;
-  const NameMap& map;
-};
+  std::vector<int> result;
+  result.reserve(graph.linksEnd(sourceRouter) - graph.linksBegin(sourceRouter));
+  for (size_t link = graph.linksBegin(sourceRouter); link < graph.linksEnd(sourceRouter); ++link) {
+    int neighbor = graph.getNeighbor(link);
+    if (neighbor != sourceRouter && graph.getCost(link) >= 0.0) {
+      result.push_back(neighbor);
+    }
+  }
+  return result;
+}
 
 /**
- * @brief Print adjacency matrix.
+ * @brief Run @p nParts computations on the worker threads.
+ * @param compute Called with each part index on some worker thread.
+ * @return Results in part order, regardless of which worker finishes first.
  */
-std::ostream&
-operator<<(std::ostream& os, const PrintAdjMatrix& p)
+template<typename Result, typename Function>
+std::vector<Result>
+runInParallel(boost::asio::thread_pool& workerPool, size_t nParts, const Function& compute)
 {
-  size_t nRouters = p.map.size();
-
-  os << "-----------Legend (routerName -> index)------\n";
-  for (size_t i = 0; i < nRouters; ++i) {
-    os << "Router:" << *p.map.getRouterNameByMappingNo(i)
-       << " Index:" << i << "\n";
+  std::vector<std::future<Result>> futures;
+  futures.reserve(nParts);
+  for (size_t i = 0; i < nParts; ++i) {
+    std::packaged_task<Result()> task([&compute, i] { return compute(i); });
+    futures.push_back(task.get_future());
+    boost::asio::post(workerPool, std::move(task));
   }
-  os << " |";
-  for (size_t i = 0; i < nRouters; ++i) {
-    os << i << " ";
-  }
-  os << "\n";
-  os << "--";
-  for (size_t i = 0; i < nRouters; ++i) {
-    os << "--";
-  }
-  os << "\n";
-
-  for (size_t i = 0; i < nRouters; i++) {
-    os << i << "|";
-    for (size_t j = 0; j < nRouters; j++) {
-      double cost = p.matrix[i][j];
-      if (cost == NO_NEXT_HOP) {
-        os << "0 ";
-      }
-      else {
-        os << cost << " ";
-      }
-    }
-    os << "\n";
+
+  // Tasks refer to the caller's state, so let all of them finish before any result is used
+  for (auto& future : futures) {
+    future.wait();
   }
 
-  return os;
+  std::vector<Result> results;
+  results.reserve(nParts);
+  for (auto& future : futures) {
+    results.push_back(future.get());
+  }
+  return results;
 }
 
 /**
- * @brief Allocate and populate adjacency matrix.
+ * @brief Compute multipath shortest paths, splitting the first hops among worker threads.
  *
- * The adjacency matrix is resized to match the number of routers in @p map .
- * Costs from Adjacency LSAs are filled into the matrix; in case of a mismatch in bidirectional
- * costs, the higher cost is assigned for both directions.
- * All other elements are set to @c NON_ADJACENT_COST .
+ * The search for one first hop never touches the state of another, so each worker handles
+ * a contiguous range of @p firstHops on its own. Results are returned in the order of
+ * @p firstHops regardless of which worker finishes first.
  */
-AdjMatrix
-makeAdjMatrix(const Lsdb& lsdb, NameMap& map)
+std::vector<MultipathDijkstraResult>
+calculateMultipathDijkstraPathInParallel(const TopologyGraph& graph, int sourceRouter,
+                                         const std::vector<double>& nodeCost,
+                                         const std::vector<int>& firstHops,
+                                         boost::asio::thread_pool* workerPool, size_t nWorkers)
 {
-  // Create the matrix to have N rows and N columns, where N is number of routers.
-  size_t nRouters = map.size();
-  AdjMatrix matrix(boost::extents[nRouters][nRouters]);
-
-  // Initialize all elements to NON_ADJACENT_COST.
-  std::fill_n(matrix.origin(), matrix.num_elements(), Adjacent::NON_ADJACENT_COST);
-
-  // For each LSA represented in the map
-  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
-  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
-    auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
-    auto row = map.getMappingNoByRouterName(adjLsa->getOriginRouter());
-
-    std::list<Adjacent> adl = adjLsa->getAdl().getAdjList();
-    // For each adjacency represented in the LSA
-    for (const auto& adjacent : adl) {
-      auto col = map.getMappingNoByRouterName(adjacent.getName());
-      double cost = adjacent.getLinkCost();
-
-      if (row && col && *row < static_cast<int32_t>(nRouters)
-          && *col < static_cast<int32_t>(nRouters)) {
-        matrix[*row][*col] = cost;
-      }
-    }
-  }
-
-  // Links that do not have the same cost for both directions should
-  // have their costs corrected:
-  //
-  //   If the cost of one side of the link is NON_ADJACENT_COST (i.e. broken) or negative,
-  //   both direction of the link should have their cost corrected to NON_ADJACENT_COST.
-  //
-  //   Otherwise, both sides of the link should use the larger of the two costs.
-  //
-  // Additionally, this means that we can halve the amount of space
-  // that the matrix uses by only maintaining a triangle.
-  // - But that is not yet implemented.
-  for (size_t row = 0; row < nRouters; ++row) {
-    for (size_t col = 0; col < nRouters; ++col) {
-      double& toCost = matrix[row][col];
-      double& fromCost = matrix[col][row];
-
-      if (fromCost == toCost) {
-        continue;
-      }
-
-      // If both sides of the link are up, use the larger cost else break the link
-      double correctedCost = Adjacent::NON_ADJACENT_COST;
-      if (toCost >= 0 && fromCost >= 0) {
-        correctedCost = std::max(toCost, fromCost);
-      }
-
-      NLSR_LOG_WARN("Cost between [" << row << "][" << col << "] and [" << col << "][" << row <<
-                "] are not the same (" << toCost << " != " << fromCost << "). " <<
-                "Correcting to cost: " << correctedCost);
-
-      toCost = correctedCost;
-      fromCost = correctedCost;
-    }
+  size_t nParts = workerPool == nullptr ? 1 : std::min(nWorkers, firstHops.size());
+  if (nParts <= 1) {
+    return {calculateMultipathDijkstraPath(graph, sourceRouter, nodeCost, firstHops)};
   }
 
-  return matrix;
+  return runInParallel<MultipathDijkstraResult>(*workerPool, nParts, [&] (size_t i) {
+    std::vector<int> part(firstHops.begin() + firstHops.size() * i / nParts,
+                          firstHops.begin() + firstHops.size() * (i + 1) / nParts);
+    return calculateMultipathDijkstraPath(graph, sourceRouter, nodeCost, part);
+  });
 }
 
-void
-sortQueueByDistance(std::vector<int>& q, const std::vector<double>& dist, size_t start)
+/**
+ * @brief Compute the shortest path tree rooted at each neighbor, on the worker threads.
+ */
+std::vector<DijkstraResult>
+calculateNeighborTrees(const TopologyGraph& graph, const std::vector<double>& nodeCost,
+                       const std::vector<int>& neighbors,
+                       boost::asio::thread_pool* workerPool, size_t nWorkers)
 {
-  for (size_t i = start; i < q.size(); ++i) {
-    for (size_t j = i + 1; j < q.size(); ++j) {
-      if (dist[q[j]] < dist[q[i]]) {
-        std::swap(q[i], q[j]);
-      }
+  auto calculateRange = [&] (size_t first, size_t last) {
+    std::vector<DijkstraResult> trees;
+    trees.reserve(last - first);
+    for (size_t k = first; k < last; ++k) {
+      trees.push_back(calculateDijkstraPath(graph, neighbors[k], nodeCost));
     }
+    return trees;
+  };
+
+  size_t nParts = workerPool == nullptr ? 1 : std::min(nWorkers, neighbors.size());
+  if (nParts <= 1) {
+    return calculateRange(0, neighbors.size());
   }
-}
 
-bool
-isNotExplored(std::vector<int>& q, int u, size_t start)
-{
-  for (size_t i = start; i < q.size(); i++) {
-    if (q[i] == u) {
-      return true;
-    }
+  std::vector<DijkstraResult> trees;
+  trees.reserve(neighbors.size());
+  for (auto& part : runInParallel<std::vector<DijkstraResult>>(*workerPool, nParts,
+         [&] (size_t i) {
+           return calculateRange(neighbors.size() * i / nParts,
+                                 neighbors.size() * (i + 1) / nParts);
+         })) {
+    std::move(part.begin(), part.end(), std::back_inserter(trees));
   }
-  return false;
+  return trees;
 }
 
-struct Link
-{
-  size_t index;
-  double cost;
-};
-
 /**
- * @brief List adjacencies and link costs from a source router.
+ * @brief Find the shortest distance and first hop toward each router over all trees.
+ *
+ * Among first hops of equal distance, the one of the earliest tree is kept.
  */
-std::vector<Link>
-gatherLinks(const AdjMatrix& matrix, int sourceRouter)
+DijkstraResult
+combineShortestPathTrees(const std::vector<DijkstraResult>& trees, size_t nRouters)
 {
-  size_t nRouters = matrix.size();
-  std::vector<Link> result;
-  result.reserve(nRouters);
-  for (size_t i = 0; i < nRouters; ++i) {
-    if (i == static_cast<size_t>(sourceRouter)) {
-      continue;
-    }
-    double cost = matrix[sourceRouter][i];
-    if (cost >= 0.0) {
-      result.emplace_back(Link{i, cost});
+  if (trees.size() == 1) {
+    return trees.front();
+  }
+
+  DijkstraResult result;
+  result.distance.assign(nRouters, INF_DISTANCE);
+  result.firstHop.assign(nRouters, NO_NEXT_HOP);
+  for (const auto& tree : trees) {
+    for (size_t i = 0; i < nRouters; ++i) {
+      if (tree.firstHop[i] != NO_NEXT_HOP && tree.distance[i] < result.distance[i]) {
+        result.distance[i] = tree.distance[i];
+        result.firstHop[i] = tree.firstHop[i];
+      }
     }
   }
   return result;
 }
 
 /**
- * @brief Adjust link costs to simulate having only one accessible neighbor.
+ * @brief Compute the cost of entering a router from its Name LSA service metrics.
  */
-void
-simulateOneNeighbor(AdjMatrix& matrix, int sourceRouter, const Link& accessibleNeighbor)
+double
+calculateNodeCost(const LsdbSnapshot& lsdb, const ndn::Name& routerName,
+                  const ConfParameter& confParam)
 {
-  size_t nRouters = matrix.size();
-  for (size_t i = 0; i < nRouters; ++i) {
-    if (i == accessibleNeighbor.index) {
-      matrix[sourceRouter][i] = accessibleNeighbor.cost;
-    }
-    else {
-      // if "i" is not a link to the source, set its cost to a non adjacent value.
-      matrix[sourceRouter][i] = Adjacent::NON_ADJACENT_COST;
-    }
+  auto nameLsa = lsdb.findLsa<NameLsa>(routerName);
+  if (!nameLsa) {
+    return 0.0;
   }
+  return nameLsa->getLoadIndex() * confParam.getLoadWeight() +
+         nameLsa->getProcessingTime() * confParam.getProcessingTimeWeight();
 }
 
-class DijkstraResult
-{
-public:
-  int
-  getNextHop(int dest, int source) const
-  {
-    int nextHop = NO_NEXT_HOP;
-    while (parent[dest] != EMPTY_PARENT) {
-      nextHop = dest;
-      dest = parent[dest];
-    }
-    if (dest != source) {
-      nextHop = NO_NEXT_HOP;
-    }
-    return nextHop;
-  }
-
-public:
-  std::vector<int> parent;
-  std::vector<double> distance;
-};
-
 /**
- * @brief Compute the shortest path from a source router to every other router.
+ * @brief Compute the cost of entering each router.
+ * @param cache If it holds costs for the same numbering as @p map , only the routers whose
+ *              Name LSA changed since are recomputed.
+ *
+ * The result is indexed by mapping number, so that the Dijkstra relaxation loop does not need
+ * to look up router names or LSAs for every edge.
  */
-DijkstraResult
-calculateDijkstraPath(const AdjMatrix& matrix, int sourceRouter, const Lsdb& lsdb, const NameMap& map)
+std::vector<double>
+makeNodeCosts(const LsdbSnapshot& lsdb, const NameMap& map, const ConfParameter& confParam,
+              const LinkStateCache* cache)
 {
-  size_t nRouters = matrix.shape()[0];
-
-  std::vector<int> parent(nRouters, EMPTY_PARENT);
-  std::vector<double> distance(nRouters, INF_DISTANCE);
-  std::vector<int> q(nRouters);
-
-  // Initialize
-  parent[sourceRouter] = sourceRouter;
-  distance[sourceRouter] = 0;
-
-  for (size_t i = 0; i < nRouters; i++) {
-    q[i] = i;
-  }
-
-  size_t start = 0;
-  while (start < nRouters) {
-    sortQueueByDistance(q, distance, start);
-    int u = q[start];
-
-    for (size_t v = 0; v < nRouters; v++) {
-      if (matrix[u][v] != Adjacent::NON_ADJACENT_COST && isNotExplored(q, v, start + 1)) {
-        double linkCost = matrix[u][v];
-        
-        // Consider service function information in cost calculation
-        if (auto routerName = map.getRouterNameByMappingNo(v)) {
-          if (auto nameLsa = lsdb.findNameLsa(*routerName)) {
-            // Add weighted service metrics to link cost
-            linkCost += nameLsa->getLoadIndex() * 0.3;  // 30% weight for load
-            linkCost += nameLsa->getProcessingTime() * 0.7;  // 70% weight for processing time
-          }
-        }
-
-        if (distance[u] + linkCost < distance[v]) {
-          distance[v] = distance[u] + linkCost;
-          parent[v] = u;
-        }
+  if (cache != nullptr && cache->nodeCost.size() == map.size()) {
+    std::vector<double> nodeCost = cache->nodeCost;
+    for (const auto& routerName : cache->changedNameLsas) {
+      if (auto i = map.getMappingNoByRouterName(routerName)) {
+        nodeCost[*i] = calculateNodeCost(lsdb, routerName, confParam);
       }
     }
-    ++start;
+    return nodeCost;
   }
 
-  return DijkstraResult{std::move(parent), std::move(distance)};
+  std::vector<double> nodeCost(map.size(), 0.0);
+  for (size_t i = 0; i < map.size(); ++i) {
+    if (auto routerName = map.getRouterNameByMappingNo(i)) {
+      nodeCost[i] = calculateNodeCost(lsdb, *routerName, confParam);
+    }
+  }
+  return nodeCost;
 }
 
+/**
+ * @brief Compute the service cost added to a next hop toward the router of @p nameLsa .
+ *
+ * A router that does not report service metrics has a service cost of zero.
+ */
 double
-calculateServiceCost(const std::shared_ptr<NameLsa>& nameLsa, const ConfParameter& confParam)
+calculateServiceCost(const std::shared_ptr<const NameLsa>& nameLsa, const ConfParameter& confParam)
 {
-  if (!nameLsa || nameLsa->getServiceName().empty()) {
-    return INF_DISTANCE;
+  if (!nameLsa) {
+    return 0.0;
   }
 
   double processingTimeWeight = confParam.getProcessingTimeWeight();
@@ -330,19 +245,59 @@ calculateServiceCost(const std::shared_ptr<NameLsa>& nameLsa, const ConfParamete
   return (processingTimeWeight * normalizedProcessingTime) + (loadWeight * loadIndex);
 }
 
-void
-addNextHopsToRoutingTable(RoutingTable& rt, const NameMap& map, int sourceRouter,
-                         const AdjacencyList& adjacencies, const DijkstraResult& dr,
-                         const Lsdb& lsdb, const ConfParameter& confParam)
+/**
+ * @brief Face and link cost of a direct neighbor of the source router.
+ */
+struct NeighborFace
 {
-  auto thisRouter = map.getRouterNameByMappingNo(sourceRouter);
-  if (!thisRouter) {
-    return;
+  ndn::FaceUri faceUri;
+  uint64_t faceId = 0;
+  double linkCost = 0.0;
+};
+
+/**
+ * @brief Index the neighbors in the adjacency list by mapping number.
+ *
+ * Built once per calculation, so that finding the face toward a next hop does not need to
+ * compare router names.
+ */
+std::vector<std::optional<NeighborFace>>
+makeNeighborFaces(const NameMap& map, const AdjacencyList& adjacencies)
+{
+  std::vector<std::optional<NeighborFace>> neighbors(map.size());
+  for (const auto& adjacent : adjacencies) {
+    auto i = map.getMappingNoByRouterName(adjacent.getName());
+    if (i && !neighbors[*i]) {
+      neighbors[*i] = NeighborFace{adjacent.getFaceUri(), adjacent.getFaceId(),
+                                   adjacent.getLinkCost()};
+    }
   }
+  return neighbors;
+}
 
+/**
+ * @brief Add the next hops of a shortest path tree to the routing table.
+ * @param neighbors Face toward each direct neighbor, see makeNeighborFaces.
+ *
+ * The first hop toward each destination is read from @p tree in one sweep over the routers.
+ */
+void
+addNextHopsToRoutingTable(RoutingTableStatus& rt, const NameMap& map,
+                          const std::vector<std::optional<NeighborFace>>& neighbors,
+                          const DijkstraResult& tree, const LsdbSnapshot& lsdb,
+                          const ConfParameter& confParam)
+{
   // For each destination router
   for (size_t i = 0; i < map.size(); ++i) {
-    if (i == static_cast<size_t>(sourceRouter)) {
+    // Get the next hop from Dijkstra; the source and unreachable routers have none
+    int nextHopRouter = tree.getNextHop(i);
+    if (nextHopRouter == NO_NEXT_HOP) {
+      continue;
+    }
+
+    // Find the face for the next hop
+    const auto& neighbor = neighbors[nextHopRouter];
+    if (!neighbor) {
       continue;
     }
 
@@ -357,82 +312,201 @@ addNextHopsToRoutingTable(RoutingTable& rt, const NameMap& map, int sourceRouter
       continue;
     }
 
-    // Calculate service cost
-    double serviceCost = calculateServiceCost(lsa, confParam);
-    
-    // Get the next hop and link cost from Dijkstra
-    int nextHopRouter = dr.getNextHop(i, sourceRouter);
-    if (nextHopRouter == NO_NEXT_HOP) {
-      continue;
-    }
+    // Combine link cost and service cost
+    double totalCost = neighbor->linkCost + calculateServiceCost(lsa, confParam);
+
+    // Add next hop to routing table
+    NextHop nh(neighbor->faceUri, totalCost);
+    rt.addNextHop(*destRouter, nh);
+  }
+}
 
-    auto nextHopRouterName = map.getRouterNameByMappingNo(nextHopRouter);
-    if (!nextHopRouterName) {
+/**
+ * @brief Attach loop-free alternates to the routing table entries.
+ * @param alternates Alternate neighbor toward each destination, see
+ *                   calculateLoopFreeAlternates.
+ */
+void
+addBackupNextHopsToRoutingTable(RoutingTableStatus& rt, const NameMap& map,
+                                const std::vector<std::optional<NeighborFace>>& neighbors,
+                                const std::vector<int>& alternates, const LsdbSnapshot& lsdb,
+                                const ConfParameter& confParam)
+{
+  for (size_t i = 0; i < map.size(); ++i) {
+    if (alternates[i] == NO_NEXT_HOP) {
       continue;
     }
 
-    // Find the face for the next hop
-    ndn::optional<uint64_t> nextHopFace;
-    double routeCost = 0.0;
-    
-    for (const auto& adjacent : adjacencies) {
-      if (adjacent.getName() == *nextHopRouterName) {
-        nextHopFace = adjacent.getFaceId();
-        routeCost = adjacent.getLinkCost();
-        break;
-      }
+    const auto& neighbor = neighbors[alternates[i]];
+    auto destRouter = map.getRouterNameByMappingNo(i);
+    if (!neighbor || !destRouter) {
+      continue;
     }
 
-    if (!nextHopFace) {
+    auto lsa = lsdb.findLsa<NameLsa>(*destRouter);
+    if (!lsa) {
       continue;
     }
 
-    // Combine link cost and service cost
-    double totalCost = routeCost + serviceCost;
+    // Same cost as a next hop through this neighbor
+    double totalCost = neighbor->linkCost + calculateServiceCost(lsa, confParam);
+    rt.setBackupNextHop(*destRouter, NextHop(neighbor->faceUri, totalCost));
+  }
+}
 
-    // Add next hop to routing table
-    NextHop nh(*nextHopFace, totalCost);
-    rt.addNextHop(*destRouter, nh);
+/**
+ * @brief Compute shortest path trees from scratch.
+ * @param firstHops First hop of each tree; @c NO_NEXT_HOP for an unrestricted tree.
+ */
+std::vector<DijkstraResult>
+calculateShortestPathTrees(const TopologyGraph& graph, int sourceRouter,
+                           const std::vector<double>& nodeCost, const std::vector<int>& firstHops,
+                           boost::asio::thread_pool* workerPool, size_t nWorkers)
+{
+  if (firstHops.size() == 1 && firstHops.front() == NO_NEXT_HOP) {
+    return {calculateDijkstraPath(graph, sourceRouter, nodeCost)};
+  }
+
+  std::vector<DijkstraResult> trees;
+  trees.reserve(firstHops.size());
+  for (auto& mr : calculateMultipathDijkstraPathInParallel(graph, sourceRouter, nodeCost,
+                                                           firstHops, workerPool, nWorkers)) {
+    std::move(mr.trees.begin(), mr.trees.end(), std::back_inserter(trees));
   }
+  return trees;
+}
+
+bool
+isSameTrees(const std::vector<DijkstraResult>& lhs, const std::vector<DijkstraResult>& rhs)
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [] (const DijkstraResult& a, const DijkstraResult& b) {
+                      return a.parent == b.parent && a.distance == b.distance &&
+                             a.hops == b.hops && a.firstHop == b.firstHop;
+                    });
 }
 
 } // anonymous namespace
 
 void
-calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt, ConfParameter& confParam,
-                              const Lsdb& lsdb)
+calculateLinkStateRoutingPath(NameMap& map, RoutingTableStatus& rt, ConfParameter& confParam,
+                              const LsdbSnapshot& lsdb, boost::asio::thread_pool* workerPool,
+                              LinkStateCache* cache)
 {
   NLSR_LOG_DEBUG("calculateLinkStateRoutingPath called");
 
+  bool isSameRouters = cache != nullptr && cache->map.hasSameRouters(map);
+  if (isSameRouters) {
+    // Keep the mapping numbers of the cached router costs and trees
+    map = cache->map;
+  }
+
   auto sourceRouter = map.getMappingNoByRouterName(confParam.getRouterPrefix());
   if (!sourceRouter) {
     NLSR_LOG_DEBUG("Source router is absent, nothing to do");
     return;
   }
 
-  AdjMatrix matrix = makeAdjMatrix(lsdb, map);
-  NLSR_LOG_DEBUG((PrintAdjMatrix{matrix, map}));
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  auto graph = TopologyGraph::createFromAdjLsdb(lsaRange.first, lsaRange.second, map);
+  NLSR_LOG_DEBUG(map);
+  NLSR_LOG_DEBUG(graph);
+
+  auto nodeCost = makeNodeCosts(lsdb, map, confParam, isSameRouters ? cache : nullptr);
+
+  // In the single path case there is one tree without restriction. In the multipath case
+  // there is one tree per neighbor, as if that neighbor were the only accessible one.
+  std::vector<int> firstHops{NO_NEXT_HOP};
+  if (confParam.getMaxFacesPerPrefix() != 1) {
+    firstHops = gatherNeighbors(graph, *sourceRouter);
+  }
 
-  if (confParam.getMaxFacesPerPrefix() == 1) {
-    // In the single path case we can simply run Dijkstra's algorithm.
-    auto dr = calculateDijkstraPath(matrix, *sourceRouter, lsdb, map);
-    // Inform the routing table of the new next hops.
-    addNextHopsToRoutingTable(rt, map, *sourceRouter, confParam.getAdjacencyList(), dr, lsdb, confParam);
+  bool canUpdate = isSameRouters && confParam.getIncrementalSpfState() != INCREMENTAL_SPF_OFF;
+  bool isValidating = confParam.getIncrementalSpfState() == INCREMENTAL_SPF_VALIDATE;
+  std::vector<LinkChange> changes;
+  if (canUpdate) {
+    changes = diffTopology(cache->graph, graph, cache->nodeCost, nodeCost);
+  }
+
+  std::vector<DijkstraResult> trees;
+  if (canUpdate && !cache->trees.empty() && cache->sourceRouter == *sourceRouter &&
+      cache->firstHops == firstHops) {
+    trees = std::move(cache->trees);
+    size_t nUpdated = 0;
+    for (size_t k = 0; k < trees.size(); ++k) {
+      nUpdated += updateDijkstraPath(trees[k], graph, nodeCost, changes, *sourceRouter,
+                                     firstHops[k]);
+    }
+    NLSR_LOG_DEBUG("Incremental SPF: " << changes.size() << " changed links, " << nUpdated <<
+                   " paths recomputed in " << trees.size() << " trees of " << map.size() <<
+                   " routers");
+
+    if (isValidating) {
+      auto expected = calculateShortestPathTrees(graph, *sourceRouter, nodeCost, firstHops,
+                                                 workerPool, confParam.getRoutingWorkerThreads());
+      if (!isSameTrees(trees, expected)) {
+        NLSR_LOG_ERROR("Incremental SPF differs from full calculation, using full calculation");
+        trees = std::move(expected);
+      }
+    }
   }
   else {
-    // Multi Path
-    // Gets a sparse listing of adjacencies for path calculation
-    auto links = gatherLinks(matrix, *sourceRouter);
-    for (const auto& link : links) {
-      // Simulate that only the current neighbor is accessible
-      simulateOneNeighbor(matrix, *sourceRouter, link);
-      NLSR_LOG_DEBUG((PrintAdjMatrix{matrix, map}));
-      // Do Dijkstra's algorithm using the current neighbor as your start.
-      auto dr = calculateDijkstraPath(matrix, *sourceRouter, lsdb, map);
-      // Update the routing table with the calculations.
-      addNextHopsToRoutingTable(rt, map, *sourceRouter, confParam.getAdjacencyList(), dr, lsdb, confParam);
+    NLSR_LOG_DEBUG("Full SPF over " << map.size() << " routers");
+    trees = calculateShortestPathTrees(graph, *sourceRouter, nodeCost, firstHops, workerPool,
+                                       confParam.getRoutingWorkerThreads());
+  }
+
+  // Loop-free alternates are chosen from the shortest paths of each neighbor
+  std::vector<int> neighbors;
+  std::vector<DijkstraResult> neighborTrees;
+  if (confParam.isFastRerouteEnabled()) {
+    neighbors = gatherNeighbors(graph, *sourceRouter);
+    if (canUpdate && !cache->neighborTrees.empty() && cache->neighbors == neighbors) {
+      neighborTrees = std::move(cache->neighborTrees);
+      for (size_t k = 0; k < neighbors.size(); ++k) {
+        updateDijkstraPath(neighborTrees[k], graph, nodeCost, changes, neighbors[k]);
+      }
+
+      if (isValidating) {
+        auto expected = calculateNeighborTrees(graph, nodeCost, neighbors, workerPool,
+                                               confParam.getRoutingWorkerThreads());
+        if (!isSameTrees(neighborTrees, expected)) {
+          NLSR_LOG_ERROR("Incremental SPF of neighbors differs from full calculation, "
+                         "using full calculation");
+          neighborTrees = std::move(expected);
+        }
+      }
+    }
+    else {
+      neighborTrees = calculateNeighborTrees(graph, nodeCost, neighbors, workerPool,
+                                             confParam.getRoutingWorkerThreads());
     }
   }
+
+  // Update the routing table with the calculations.
+  auto neighborFaces = makeNeighborFaces(map, lsdb.getAdjacencyList());
+  for (const auto& tree : trees) {
+    addNextHopsToRoutingTable(rt, map, neighborFaces, tree, lsdb, confParam);
+  }
+
+  if (confParam.isFastRerouteEnabled()) {
+    auto alternates = calculateLoopFreeAlternates(graph, *sourceRouter, nodeCost,
+                                                  combineShortestPathTrees(trees, map.size()),
+                                                  neighbors, neighborTrees);
+    addBackupNextHopsToRoutingTable(rt, map, neighborFaces, alternates, lsdb, confParam);
+  }
+
+  if (cache != nullptr) {
+    cache->map = map;
+    cache->graph = std::move(graph);
+    cache->nodeCost = std::move(nodeCost);
+    cache->changedNameLsas.clear();
+    cache->sourceRouter = *sourceRouter;
+    cache->firstHops = std::move(firstHops);
+    cache->trees = std::move(trees);
+    cache->neighbors = std::move(neighbors);
+    cache->neighborTrees = std::move(neighborTrees);
+  }
 }
 
 } // namespace nlsr
@@ -22,21 +22,94 @@
 #define NLSR_ROUTING_CALCULATOR_HPP
 
 #include "common.hpp"
-#include "lsdb.hpp"
+#include "lsdb-snapshot.hpp"
+#include "name-map.hpp"
+#include "shortest-path.hpp"
+#include "topology-graph.hpp"
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <set>
 
 namespace nlsr {
 
-class NameMap;
-class RoutingTable;
+class RoutingTableStatus;
+
+/**
+ * @brief State of the previous link-state calculation.
+ *
+ * When the same cache is passed to consecutive calculations over the same set of routers,
+ * router costs are only recomputed for routers in @c changedNameLsas , and the trees are
+ * repaired where links or router costs changed instead of being recomputed.
+ */
+struct LinkStateCache
+{
+  NameMap map;
+  TopologyGraph graph;
+  /// Cost of entering each router, derived from its Name LSA
+  std::vector<double> nodeCost;
+  /// Routers whose Name LSA was installed, updated or removed since @c nodeCost was computed
+  std::set<ndn::Name> changedNameLsas;
+  int sourceRouter = NO_NEXT_HOP;
+  /// First hop of each tree; a single @c NO_NEXT_HOP in the single path case
+  std::vector<int> firstHops;
+  std::vector<DijkstraResult> trees;
+  /// Neighbors of the source router, when loop-free alternates are computed
+  std::vector<int> neighbors;
+  /// Shortest path tree rooted at each of @c neighbors
+  std::vector<DijkstraResult> neighborTrees;
+};
 
+/**
+ * @brief State of the previous hyperbolic calculation.
+ *
+ * When the same cache is passed to consecutive calculations over the same set of routers, the
+ * distances from each neighbor are kept, and only the distances to and from routers in
+ * @c changedCoordinateLsas are recomputed.
+ */
+struct HyperbolicCache
+{
+  NameMap map;
+  /// Routers whose Coordinate LSA was installed or updated since @c distances was computed
+  std::set<ndn::Name> changedCoordinateLsas;
+  /// Distances from each neighbor to every router, indexed by mapping number; empty for
+  /// routers that were not used as a neighbor
+  std::vector<std::vector<double>> distances;
+};
+
+/**
+ * @brief Calculate link-state routes and add them to the routing table.
+ * @param map Routers in the Adjacency LSAs. If @p cache holds the same routers, @p map is
+ *            replaced with the cached numbering.
+ * @param lsdb LSAs and adjacencies to calculate from; next hops use the faces of its
+ *             adjacencies.
+ * @param workerPool If not null, multipath shortest paths are computed on these threads,
+ *                   split into as many parts as configured worker threads. Results are
+ *                   added to @p rt on the calling thread in a deterministic order.
+ * @param cache If not null, router costs are reused from the previous calculation, its trees
+ *              are updated incrementally when incremental SPF is enabled and possible, and
+ *              the new state is stored in it.
+ *
+ * If fast reroute is enabled, each routing table entry also gets a loop-free alternate
+ * next hop, see calculateLoopFreeAlternates.
+ */
 void
-calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt, ConfParameter& confParam,
-                              const Lsdb& lsdb);
+calculateLinkStateRoutingPath(NameMap& map, RoutingTableStatus& rt, ConfParameter& confParam,
+                              const LsdbSnapshot& lsdb,
+                              boost::asio::thread_pool* workerPool = nullptr,
+                              LinkStateCache* cache = nullptr);
 
+/**
+ * @brief Calculate hyperbolic routes and add them to the routing table.
+ * @param map Routers in the Coordinate LSAs. If @p cache holds the same routers, @p map is
+ *            replaced with the cached numbering.
+ * @param cache If not null, distances are reused from the previous calculation where the
+ *              coordinates of both routers are unchanged, and the new distances are stored in it.
+ */
 void
-calculateHyperbolicRoutingPath(NameMap& map, RoutingTable& rt, Lsdb& lsdb,
-                               AdjacencyList& adjacencies, ndn::Name thisRouterName,
-                               bool isDryRun);
+calculateHyperbolicRoutingPath(NameMap& map, RoutingTableStatus& rt, const LsdbSnapshot& lsdb,
+                               ndn::Name thisRouterName, bool isDryRun,
+                               HyperbolicCache* cache = nullptr);
 
 } // namespace nlsr
 
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "routing-table-diff.hpp"
+
+namespace nlsr {
+
+RoutingTableDiff
+diffRoutingTables(const RoutingTableEntryList& oldTable, const RoutingTableEntryList& newTable)
+{
+  RoutingTableDiff diff;
+
+  for (const auto& rte : oldTable) {
+    if (newTable.find(rte.getDestination()) == nullptr) {
+      diff.removed.push_back({rte.getDestination(), rte.getNexthopList(), {}});
+    }
+  }
+
+  for (const auto& rte : newTable) {
+    const auto* oldRte = oldTable.find(rte.getDestination());
+    if (oldRte == nullptr) {
+      diff.added.push_back({rte.getDestination(), {}, rte.getNexthopList()});
+    }
+    else if (oldRte->getNexthopList() != rte.getNexthopList()) {
+      diff.changed.push_back({rte.getDestination(), oldRte->getNexthopList(),
+                              rte.getNexthopList()});
+    }
+  }
+
+  return diff;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const RoutingTableDiff& diff)
+{
+  os << "Routing table changes: " << diff.added.size() << " added, "
+     << diff.removed.size() << " removed, " << diff.changed.size() << " changed\n";
+  for (const auto& change : diff.added) {
+    os << "  + " << change.destination << "\n";
+  }
+  for (const auto& change : diff.removed) {
+    os << "  - " << change.destination << "\n";
+  }
+  for (const auto& change : diff.changed) {
+    os << "  * " << change.destination << "\n";
+  }
+  return os;
+}
+
+} // namespace nlsr
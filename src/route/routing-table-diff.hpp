@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_ROUTING_TABLE_DIFF_HPP
+#define NLSR_ROUTE_ROUTING_TABLE_DIFF_HPP
+
+#include "routing-table-entry-list.hpp"
+
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Change in the next hops toward one destination router.
+ *
+ * @c oldNexthops is empty for a destination that was added, and @c newNexthops is empty for
+ * one that was removed.
+ */
+struct RoutingTableChange
+{
+  ndn::Name destination;
+  NexthopList oldNexthops;
+  NexthopList newNexthops;
+};
+
+/**
+ * @brief Difference between two routing tables, as announced by RoutingTable::afterRoutingChange.
+ *
+ * Only next hop lists are compared; backup next hops are not installed in the FIB, so a change
+ * that only affects them is not listed.
+ */
+class RoutingTableDiff
+{
+public:
+  bool
+  empty() const
+  {
+    return added.empty() && removed.empty() && changed.empty();
+  }
+
+  size_t
+  size() const
+  {
+    return added.size() + removed.size() + changed.size();
+  }
+
+public:
+  /// Destinations that are only in the new table
+  std::vector<RoutingTableChange> added;
+  /// Destinations that are only in the old table
+  std::vector<RoutingTableChange> removed;
+  /// Destinations in both tables whose next hops differ
+  std::vector<RoutingTableChange> changed;
+};
+
+/**
+ * @brief Compute the changes that turn @p oldTable into @p newTable .
+ *
+ * Destinations are looked up in the index of the other table, so this takes time linear in
+ * the size of the tables. Changes are listed in the order of the table they come from.
+ */
+RoutingTableDiff
+diffRoutingTables(const RoutingTableEntryList& oldTable, const RoutingTableEntryList& newTable);
+
+std::ostream&
+operator<<(std::ostream& os, const RoutingTableDiff& diff);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_ROUTING_TABLE_DIFF_HPP
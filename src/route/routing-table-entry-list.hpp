@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_ROUTING_TABLE_ENTRY_LIST_HPP
+#define NLSR_ROUTE_ROUTING_TABLE_ENTRY_LIST_HPP
+
+#include "routing-table-entry.hpp"
+
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Routing table entries, indexed by destination.
+ *
+ *  Entries are stored contiguously in the order they were first inserted, which is the order
+ *  they are iterated and encoded in. A hash index on the destination name makes lookups take
+ *  constant time, so building a table of N destinations takes O(N) rather than O(N^2).
+ */
+class RoutingTableEntryList
+{
+public:
+  using const_iterator = std::vector<RoutingTableEntry>::const_iterator;
+  using const_reverse_iterator = std::vector<RoutingTableEntry>::const_reverse_iterator;
+
+  RoutingTableEntryList() = default;
+
+  RoutingTableEntryList(std::initializer_list<RoutingTableEntry> entries)
+  {
+    for (const auto& rte : entries) {
+      push_back(rte);
+    }
+  }
+
+  /*! \brief Finds the entry of \p destination .
+   *  \return The entry, or nullptr if there is none.
+   */
+  RoutingTableEntry*
+  find(const ndn::Name& destination)
+  {
+    auto it = m_index.find(destination);
+    return it != m_index.end() ? &m_entries[it->second] : nullptr;
+  }
+
+  const RoutingTableEntry*
+  find(const ndn::Name& destination) const
+  {
+    auto it = m_index.find(destination);
+    return it != m_index.end() ? &m_entries[it->second] : nullptr;
+  }
+
+  /*! \brief Finds the entry of \p destination , appending an empty one if there is none. */
+  RoutingTableEntry&
+  findOrInsert(const ndn::Name& destination)
+  {
+    auto [it, isNew] = m_index.try_emplace(destination, m_entries.size());
+    if (isNew) {
+      m_entries.emplace_back(destination);
+    }
+    return m_entries[it->second];
+  }
+
+  /*! \brief Appends \p rte , unless its destination already has an entry.
+   *  \return Whether \p rte was appended.
+   */
+  bool
+  push_back(const RoutingTableEntry& rte)
+  {
+    if (!m_index.try_emplace(rte.getDestination(), m_entries.size()).second) {
+      return false;
+    }
+    m_entries.push_back(rte);
+    return true;
+  }
+
+  /*! \brief Gives access to the entries in place; destinations must not be changed. */
+  std::vector<RoutingTableEntry>::iterator
+  begin()
+  {
+    return m_entries.begin();
+  }
+
+  std::vector<RoutingTableEntry>::iterator
+  end()
+  {
+    return m_entries.end();
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_entries.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_entries.end();
+  }
+
+  const_reverse_iterator
+  rbegin() const
+  {
+    return m_entries.rbegin();
+  }
+
+  const_reverse_iterator
+  rend() const
+  {
+    return m_entries.rend();
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_entries.empty();
+  }
+
+  void
+  clear()
+  {
+    m_entries.clear();
+    m_index.clear();
+  }
+
+private:
+  std::vector<RoutingTableEntry> m_entries;
+  /// Position of each destination's entry in m_entries
+  std::unordered_map<ndn::Name, size_t> m_index;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_ROUTING_TABLE_ENTRY_LIST_HPP
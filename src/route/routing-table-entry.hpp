@@ -28,6 +28,8 @@
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/name.hpp>
 
+#include <optional>
+
 namespace nlsr {
 
 /*! \brief Data abstraction for RouteTableInfo
@@ -73,6 +75,25 @@ public:
     return m_nexthopList;
   }
 
+  /*! \brief Loop-free alternate to fall back on when a neighbor in the next hop list fails.
+   *
+   *  It is kept apart from the next hop list, so it is neither installed in the FIB nor
+   *  encoded until RoutingTable::switchToBackupNextHops uses it. It is then installed with a
+   *  cost above that of every primary next hop.
+   */
+  const std::optional<NextHop>&
+  getBackupNextHop() const
+  {
+    return m_backupNextHop;
+  }
+
+  void
+  setBackupNextHop(const NextHop& nh)
+  {
+    m_backupNextHop = nh;
+    m_backupNextHop->setBackup(true);
+  }
+
   inline bool
   operator==(RoutingTableEntry& rhs)
   {
@@ -93,6 +114,7 @@ public:
 protected:
   ndn::Name m_destination;
   NexthopList m_nexthopList;
+  std::optional<NextHop> m_backupNextHop;
 
   mutable ndn::Block m_wire;
 };
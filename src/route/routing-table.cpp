@@ -21,6 +21,7 @@
 #include "routing-table.hpp"
 #include "name-map.hpp"
 #include "routing-calculator.hpp"
+#include "routing-table-diff.hpp"
 #include "routing-table-entry.hpp"
 
 #include "conf-parameter.hpp"
@@ -28,19 +29,33 @@
 #include "nlsr.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <boost/asio/post.hpp>
+
 namespace nlsr {
 
 INIT_LOGGER(route.RoutingTable);
 
-RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter& confParam)
+RoutingTable::RoutingTable(ndn::Scheduler& scheduler, boost::asio::io_context& io, Lsdb& lsdb,
+                           ConfParameter& confParam)
   : m_scheduler(scheduler)
+  , m_io(io)
   , m_lsdb(lsdb)
   , m_routingCalcInterval{confParam.getRoutingCalcInterval()}
+  , m_routingCalcInitialWait{confParam.getRoutingCalcInitialWait()}
+  , m_routingCalcIncrement{confParam.getRoutingCalcIncrement()}
   , m_isRoutingTableCalculating(false)
   , m_isRouteCalculationScheduled(false)
   , m_confParam(confParam)
   , m_hyperbolicState(m_confParam.getHyperbolicState())
 {
+  if (m_confParam.getRoutingWorkerThreads() > 1) {
+    m_workerPool = std::make_unique<boost::asio::thread_pool>(m_confParam.getRoutingWorkerThreads());
+  }
+  // The calculation waits for the worker pool, so it cannot run on one of its threads
+  if (m_confParam.isAsyncCalculationEnabled()) {
+    m_calculationThread = std::make_unique<boost::asio::thread_pool>(1);
+  }
+
   m_afterLsdbModified = lsdb.onLsdbModified.connect(
     [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
             const auto& namesToAdd, const auto& namesToRemove) {
@@ -49,16 +64,32 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
                                       type == Lsa::Type::ADJACENCY;
       bool scheduleCalculation = false;
 
+      if (type == Lsa::Type::NAME) {
+        // Only the processing time and load index of a Name LSA enter the calculation
+        if (updateNameLsaMetrics(static_cast<const NameLsa&>(*lsa), updateType)) {
+          // Cost of entering this router must be recomputed in the next calculation
+          m_changedNameLsas.insert(lsa->getOriginRouter());
+          scheduleCalculation = m_hyperbolicState != HYPERBOLIC_STATE_ON;
+        }
+      }
+      else if (type == Lsa::Type::COORDINATE) {
+        // Distances to and from this router must be recomputed in the next calculation
+        m_changedCoordinateLsas.insert(lsa->getOriginRouter());
+      }
+
       if (updateType == LsdbUpdate::REMOVED && updateForOwnAdjacencyLsa) {
         // If own Adjacency LSA is removed then we have no ACTIVE neighbors.
         // (Own Coordinate LSA is never removed. But routing table calculation is scheduled
         // in HelloProtocol. The routing table calculator for HR takes into account
         // the INACTIVE status of the link).
         NLSR_LOG_DEBUG("No Adj LSA of router itself, routing table can not be calculated :(");
+        auto diff = diffRoutingTables(m_rTable, {});
         clearRoutingTable();
         clearDryRoutingTable();
-        NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-        afterRoutingChange(m_rTable);
+        if (!diff.empty()) {
+          NLSR_LOG_DEBUG("Calling Update NPT With new Route");
+          afterRoutingChange(diff);
+        }
         NLSR_LOG_DEBUG(*this);
         m_ownAdjLsaExist = false;
       }
@@ -76,152 +107,313 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
       }
 
       if (scheduleCalculation) {
+        // A calculation in flight works on a snapshot that no longer matches the LSDB
+        cancelCalculation();
         scheduleRoutingTableCalculation();
       }
     }
   );
 }
 
+RoutingTable::~RoutingTable()
+{
+  m_afterLsdbModified.disconnect();
+
+  if (m_calculationThread) {
+    // The result of a calculation in flight can no longer be installed
+    if (m_isCalculationCancelled) {
+      *m_isCalculationCancelled = true;
+    }
+    m_calculationThread->join();
+  }
+}
+
 void
 RoutingTable::calculate()
 {
   m_lsdb.writeLog();
   NLSR_LOG_TRACE("Calculating routing table");
 
-  if (m_isRoutingTableCalculating == false) {
-    m_isRoutingTableCalculating = true;
+  m_isRouteCalculationScheduled = false;
+  m_lastRoutingCalcTime = ndn::time::steady_clock::now();
 
-    if (m_hyperbolicState == HYPERBOLIC_STATE_OFF) {
-      calculateLsRoutingTable();
-    }
-    else if (m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
-      calculateLsRoutingTable();
-      calculateHypRoutingTable(true);
-    }
-    else if (m_hyperbolicState == HYPERBOLIC_STATE_ON) {
-      calculateHypRoutingTable(false);
-    }
-
-    m_isRouteCalculationScheduled = false;
-    m_isRoutingTableCalculating = false;
-  }
-  else {
+  if (m_isRoutingTableCalculating) {
+    // Calculate again once the calculation in flight is done
     scheduleRoutingTableCalculation();
+    return;
   }
-}
 
-void
-RoutingTable::calculateLsRoutingTable()
-{
-  NLSR_LOG_TRACE("CalculateLsRoutingTable Called");
+  bool isLinkState = m_hyperbolicState != HYPERBOLIC_STATE_ON;
+  bool isHyperbolic = m_hyperbolicState != HYPERBOLIC_STATE_OFF;
+  bool isDryRun = m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN;
 
-  if (m_lsdb.getIsBuildAdjLsaScheduled()) {
+  if (isLinkState && m_lsdb.getIsBuildAdjLsaScheduled()) {
     NLSR_LOG_DEBUG("Adjacency build is scheduled, routing table can not be calculated :(");
-    return;
+    isLinkState = false;
   }
 
   // We only check this in LS since we never remove our own Coordinate LSA,
   // whereas we remove our own Adjacency LSA if we don't have any neighbors
-  if (!m_ownAdjLsaExist) {
+  if (isLinkState && !m_ownAdjLsaExist) {
+    isLinkState = false;
+  }
+
+  if (!isLinkState && !isHyperbolic) {
     return;
   }
 
-  clearRoutingTable();
+  m_isRoutingTableCalculating = true;
 
-  auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
-  auto map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
-  NLSR_LOG_DEBUG(map);
+  // No calculation is in flight, so the cache can be handed the pending changes
+  m_linkStateCache.changedNameLsas.insert(m_changedNameLsas.begin(), m_changedNameLsas.end());
+  m_changedNameLsas.clear();
+  m_hyperbolicCache.changedCoordinateLsas.insert(m_changedCoordinateLsas.begin(),
+                                                 m_changedCoordinateLsas.end());
+  m_changedCoordinateLsas.clear();
+
+  // Only a calculation off the main thread needs its own copy of the LSDB
+  auto snapshot = std::make_shared<const LsdbSnapshot>(m_lsdb, m_confParam.getAdjacencyList(),
+                                                       m_calculationThread != nullptr);
+  auto isCancelled = std::make_shared<std::atomic<bool>>(false);
+
+  auto calculateTables = [this, snapshot, isCancelled, isLinkState, isHyperbolic, isDryRun] {
+    RoutingTableStatus result;
+    if (isLinkState) {
+      calculateLsRoutingTable(*snapshot, result);
+    }
+    if (isHyperbolic && !*isCancelled) {
+      calculateHypRoutingTable(*snapshot, result, isDryRun);
+    }
+    return result;
+  };
 
-  calculateLinkStateRoutingPath(map, *this, m_confParam, m_lsdb);
+  if (!m_calculationThread) {
+    installRoutingTable(calculateTables(), isLinkState, isHyperbolic);
+    m_isRoutingTableCalculating = false;
+    return;
+  }
+
+  m_isCalculationCancelled = isCancelled;
+  boost::asio::post(*m_calculationThread,
+                    [this, calculateTables, isCancelled, isLinkState, isHyperbolic] {
+    auto result = std::make_shared<RoutingTableStatus>(calculateTables());
+
+    // The routing table may be gone by the time this runs; it only holds the flag while alive
+    std::weak_ptr<std::atomic<bool>> weakIsCancelled = isCancelled;
+    boost::asio::post(m_io, [this, result, weakIsCancelled, isLinkState, isHyperbolic] {
+      auto isCancelled = weakIsCancelled.lock();
+      if (isCancelled == nullptr || isCancelled != m_isCalculationCancelled) {
+        return;
+      }
 
-  NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-  afterRoutingChange(m_rTable);
-  NLSR_LOG_DEBUG(*this);
+      m_isCalculationCancelled.reset();
+      m_isRoutingTableCalculating = false;
+      if (*isCancelled) {
+        // The change that cancelled it has scheduled the next calculation
+        NLSR_LOG_DEBUG("LSDB changed during routing table calculation, discarding result");
+        return;
+      }
+      installRoutingTable(std::move(*result), isLinkState, isHyperbolic);
+    });
+  });
 }
 
 void
-RoutingTable::calculateHypRoutingTable(bool isDryRun)
+RoutingTable::calculateLsRoutingTable(const LsdbSnapshot& lsdb, RoutingTableStatus& rt)
 {
-  if (isDryRun) {
-    clearDryRoutingTable();
-  }
-  else {
-    clearRoutingTable();
-  }
+  NLSR_LOG_TRACE("CalculateLsRoutingTable Called");
 
-  auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  auto map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  NLSR_LOG_DEBUG(map);
+
+  calculateLinkStateRoutingPath(map, rt, m_confParam, lsdb, m_workerPool.get(),
+                                &m_linkStateCache);
+}
+
+void
+RoutingTable::calculateHypRoutingTable(const LsdbSnapshot& lsdb, RoutingTableStatus& rt,
+                                       bool isDryRun)
+{
+  auto lsaRange = lsdb.getLsdbIterator<CoordinateLsa>();
   auto map = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
   NLSR_LOG_DEBUG(map);
 
-  calculateHyperbolicRoutingPath(map, *this, m_lsdb, m_confParam.getAdjacencyList(),
-                                 m_confParam.getRouterPrefix(), isDryRun);
+  calculateHyperbolicRoutingPath(map, rt, lsdb, m_confParam.getRouterPrefix(), isDryRun,
+                                 &m_hyperbolicCache);
+}
 
-  if (!isDryRun) {
+void
+RoutingTable::installRoutingTable(RoutingTableStatus&& result, bool isLinkState,
+                                  bool isHyperbolic)
+{
+  bool isDryRun = m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN;
+  if (isHyperbolic && isDryRun) {
+    m_dryTable = std::move(result.m_dryTable);
+    m_wire.reset();
+  }
+
+  if (isLinkState || (isHyperbolic && !isDryRun)) {
+    auto diff = diffRoutingTables(m_rTable, result.m_rTable);
+    m_rTable = std::move(result.m_rTable);
+    m_wire.reset();
+    if (diff.empty()) {
+      NLSR_LOG_DEBUG("Routing table unchanged, nothing to update in NPT");
+      return;
+    }
     NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-    afterRoutingChange(m_rTable);
+    NLSR_LOG_TRACE(diff);
+    afterRoutingChange(diff);
     NLSR_LOG_DEBUG(*this);
   }
 }
 
+void
+RoutingTable::cancelCalculation()
+{
+  if (m_isCalculationCancelled && !*m_isCalculationCancelled) {
+    NLSR_LOG_DEBUG("Cancelling routing table calculation in flight");
+    *m_isCalculationCancelled = true;
+  }
+}
+
+bool
+RoutingTable::updateNameLsaMetrics(const NameLsa& lsa, LsdbUpdate updateType)
+{
+  // A router without a Name LSA costs nothing to enter
+  std::pair<double, double> oldMetrics{0.0, 0.0};
+  std::pair<double, double> newMetrics{0.0, 0.0};
+
+  auto it = m_nameLsaMetrics.find(lsa.getOriginRouter());
+  if (it != m_nameLsaMetrics.end()) {
+    oldMetrics = it->second;
+  }
+
+  if (updateType == LsdbUpdate::REMOVED) {
+    if (it != m_nameLsaMetrics.end()) {
+      m_nameLsaMetrics.erase(it);
+    }
+  }
+  else {
+    newMetrics = {lsa.getProcessingTime(), lsa.getLoadIndex()};
+    m_nameLsaMetrics[lsa.getOriginRouter()] = newMetrics;
+  }
+  return newMetrics != oldMetrics;
+}
+
 void
 RoutingTable::scheduleRoutingTableCalculation()
 {
-  if (!m_isRouteCalculationScheduled) {
-    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << m_routingCalcInterval);
-    m_scheduler.schedule(m_routingCalcInterval, [this] { calculate(); });
-    m_isRouteCalculationScheduled = true;
+  if (m_isRouteCalculationScheduled) {
+    // This change is covered by the calculation already scheduled
+    rtIncrementSignal(Statistics::PacketType::ROUTING_CALC_SAVED);
+    return;
   }
+
+  auto delay = getRoutingCalcDelay();
+  NLSR_LOG_DEBUG("Scheduling routing table calculation in " << delay);
+  m_scheduler.schedule(delay, [this] { calculate(); });
+  m_isRouteCalculationScheduled = true;
+  rtIncrementSignal(Statistics::PacketType::ROUTING_CALC_SCHEDULED);
 }
 
-static bool
-routingTableEntryCompare(RoutingTableEntry& rte, ndn::Name& destRouter)
+ndn::time::milliseconds
+RoutingTable::getRoutingCalcDelay()
 {
-  return rte.getDestination() == destRouter;
+  using ndn::time::milliseconds;
+
+  auto elapsed = ndn::time::duration_cast<milliseconds>(ndn::time::steady_clock::now() -
+                                                        m_lastRoutingCalcTime);
+  if (elapsed >= 2 * m_routingCalcHoldTime) {
+    // Quiet period: calculate right away, and back off if more changes follow
+    m_routingCalcHoldTime = std::min<milliseconds>(m_routingCalcIncrement, m_routingCalcInterval);
+    return std::min<milliseconds>(m_routingCalcInitialWait, m_routingCalcInterval);
+  }
+
+  // Wait until the hold time since the last calculation is over, then double the hold time
+  auto delay = std::max(m_routingCalcInitialWait, m_routingCalcHoldTime - elapsed);
+  m_routingCalcHoldTime = std::min<milliseconds>(2 * m_routingCalcHoldTime, m_routingCalcInterval);
+  return std::min<milliseconds>(delay, m_routingCalcInterval);
 }
 
 void
-RoutingTable::addNextHop(const ndn::Name& destRouter, NextHop& nh)
+RoutingTableStatus::addNextHop(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " for destination: " << destRouter);
 
-  RoutingTableEntry* rteChk = findRoutingTableEntry(destRouter);
-  if (rteChk == nullptr) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_rTable.push_back(rte);
-  }
-  else {
-    rteChk->getNexthopList().addNextHop(nh);
-  }
+  m_rTable.findOrInsert(destRouter).getNexthopList().addNextHop(nh);
   m_wire.reset();
 }
 
-RoutingTableEntry*
-RoutingTable::findRoutingTableEntry(const ndn::Name& destRouter)
+void
+RoutingTableStatus::setBackupNextHop(const ndn::Name& destRouter, const NextHop& nh)
 {
-  auto it = std::find_if(m_rTable.begin(), m_rTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it != m_rTable.end()) {
-    return &(*it);
+  RoutingTableEntry* rte = findRoutingTableEntry(destRouter);
+  if (rte == nullptr) {
+    return;
   }
-  return nullptr;
+  NLSR_LOG_DEBUG("Setting backup " << nh << " for destination: " << destRouter);
+  rte->setBackupNextHop(nh);
 }
 
 void
-RoutingTable::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
+RoutingTable::switchToBackupNextHops(const ndn::FaceUri& faceUri)
 {
-  NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
+  if (!m_confParam.isFastRerouteEnabled()) {
+    return;
+  }
 
-  auto it = std::find_if(m_dryTable.begin(), m_dryTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it == m_dryTable.end()) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_dryTable.push_back(rte);
+  RoutingTableDiff diff;
+  for (auto& rte : m_rTable) {
+    NexthopList remaining;
+    for (const auto& nh : rte.getNexthopList()) {
+      if (nh.getConnectingFaceUri() != faceUri) {
+        remaining.addNextHop(nh);
+      }
+    }
+    if (remaining.size() == rte.getNexthopList().size()) {
+      continue;
+    }
+
+    const auto& backup = rte.getBackupNextHop();
+    if (backup && backup->getConnectingFaceUri() != faceUri) {
+      // The backup only takes the traffic the remaining primary next hops cannot carry, so it
+      // must cost more than any of them
+      double maxPrimaryCost = 0.0;
+      for (const auto& nh : rte.getNexthopList()) {
+        if (!nh.isBackup()) {
+          maxPrimaryCost = std::max(maxPrimaryCost, nh.getRouteCost());
+        }
+      }
+      NextHop backupHop(*backup);
+      backupHop.setRouteCost(std::max(backup->getRouteCost(), maxPrimaryCost + 1));
+      remaining.addNextHop(backupHop);
+    }
+    NLSR_LOG_DEBUG("Switching " << rte.getDestination() << " away from " << faceUri <<
+                   ", " << remaining.size() << " next hops left");
+    diff.changed.push_back({rte.getDestination(), rte.getNexthopList(), remaining});
+    rte.getNexthopList() = remaining;
   }
-  else {
-    it->getNexthopList().addNextHop(nh);
+
+  if (!diff.empty()) {
+    m_wire.reset();
+    NLSR_LOG_DEBUG("Calling Update NPT With backup routes");
+    afterRoutingChange(diff);
   }
+}
+
+RoutingTableEntry*
+RoutingTableStatus::findRoutingTableEntry(const ndn::Name& destRouter)
+{
+  return m_rTable.find(destRouter);
+}
+
+void
+RoutingTableStatus::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
+{
+  NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
+
+  m_dryTable.findOrInsert(destRouter).getNexthopList().addNextHop(nh);
   m_wire.reset();
 }
 
@@ -293,14 +485,10 @@ RoutingTableStatus::wireDecode(const ndn::Block& wire)
   m_wire.parse();
   auto val = m_wire.elements_begin();
 
-  std::set<ndn::Name> destinations;
   for (; val != m_wire.elements_end() && val->type() == nlsr::tlv::RoutingTableEntry; ++val) {
     auto entry = RoutingTableEntry(*val);
 
-    if (destinations.emplace(entry.getDestination()).second) {
-      m_rTable.push_back(entry);
-    }
-    else {
+    if (!m_rTable.push_back(entry)) {
       // If destination already exists then this is the start of dry HR table
       m_dryTable.push_back(entry);
     }
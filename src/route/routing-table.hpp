@@ -24,13 +24,25 @@
 #include "conf-parameter.hpp"
 #include "routing-table-entry.hpp"
 #include "signals.hpp"
+#include "statistics.hpp"
 #include "lsdb.hpp"
 #include "route/fib.hpp"
+#include "route/lsdb-snapshot.hpp"
+#include "route/routing-calculator.hpp"
+#include "route/routing-table-diff.hpp"
+#include "route/routing-table-entry-list.hpp"
 #include "test-access-control.hpp"
 #include "route/name-prefix-table.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <atomic>
+#include <map>
+#include <set>
+
 namespace nlsr {
 
 class NextHop;
@@ -54,18 +66,43 @@ public:
     wireDecode(block);
   }
 
-  const std::list<RoutingTableEntry>&
+  const RoutingTableEntryList&
   getRoutingTableEntry() const
   {
     return m_rTable;
   }
 
-  const std::list<RoutingTableEntry>&
+  const RoutingTableEntryList&
   getDryRoutingTableEntry() const
   {
     return m_dryTable;
   }
 
+  /*! \brief Adds a next hop to a routing table entry.
+   *  \param destRouter The destination router whose RTE we want to modify.
+   *  \param nh The next hop to add to the RTE.
+   */
+  void
+  addNextHop(const ndn::Name& destRouter, NextHop& nh);
+
+  /*! \brief Adds a next hop to a routing table entry in a dry run scenario.
+   *  \param destRouter The destination router whose RTE we want to modify.
+   *  \param nh The next hop to add to the router.
+   */
+  void
+  addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
+
+  /*! \brief Sets the loop-free alternate of a routing table entry.
+   *  \param destRouter The destination router whose RTE we want to modify; it must already
+   *  have next hops.
+   *  \param nh The alternate next hop.
+   */
+  void
+  setBackupNextHop(const ndn::Name& destRouter, const NextHop& nh);
+
+  RoutingTableEntry*
+  findRoutingTableEntry(const ndn::Name& destRouter);
+
   const ndn::Block&
   wireEncode() const;
 
@@ -77,9 +114,12 @@ private:
   size_t
   wireEncode(ndn::EncodingImpl<TAG>& block) const;
 
+  // installs the tables of a RoutingTableStatus filled by a calculation
+  friend class RoutingTable;
+
 PUBLIC_WITH_TESTS_ELSE_PROTECTED:
-  std::list<RoutingTableEntry> m_dryTable;
-  std::list<RoutingTableEntry> m_rTable;
+  RoutingTableEntryList m_dryTable;
+  RoutingTableEntryList m_rTable;
   mutable ndn::Block m_wire;
 };
 
@@ -90,51 +130,80 @@ class RoutingTable : public RoutingTableStatus
 {
 public:
   explicit
-  RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter& confParam);
+  RoutingTable(ndn::Scheduler& scheduler, boost::asio::io_context& io, Lsdb& lsdb,
+               ConfParameter& confParam);
 
-  ~RoutingTable()
-  {
-    m_afterLsdbModified.disconnect();
-  }
+  ~RoutingTable();
 
   /*! \brief Calculates a list of next hops for each router in the network.
    *
-   *  Calculates the list of next hops to every other router in the network.
+   *  Calculates the list of next hops to every other router in the network, from a snapshot
+   *  of the LSDB. When asynchronous calculation is enabled, the calculation runs on a
+   *  background thread and its result is swapped in on the main thread, before
+   *  afterRoutingChange is emitted. A result is discarded if the LSDB has changed since the
+   *  snapshot was taken; another calculation is scheduled instead.
+   *
+   *  Only the destinations whose next hops changed are announced, and nothing is announced
+   *  if the table stays the same.
    */
   void
   calculate();
 
-  /*! \brief Adds a next hop to a routing table entry.
-   *  \param destRouter The destination router whose RTE we want to modify.
-   *  \param nh The next hop to add to the RTE.
-   */
-  void
-  addNextHop(const ndn::Name& destRouter, NextHop& nh);
-
-  /*! \brief Adds a next hop to a routing table entry in a dry run scenario.
-   *  \param destRouter The destination router whose RTE we want to modify.
-   *  \param nh The next hop to add to the router.
+  /*! \brief Replaces next hops through a failed neighbor with loop-free alternates.
+   *  \param faceUri Face URI of the neighbor that was detected as down.
+   *
+   *  Every routing table entry that had a next hop on this face falls back on its backup
+   *  next hop, if any, and the change is announced through afterRoutingChange so that the
+   *  FIB is updated right away. The routing table calculation that follows the topology
+   *  change replaces these entries. Does nothing unless fast reroute is enabled.
    */
   void
-  addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
-
-  RoutingTableEntry*
-  findRoutingTableEntry(const ndn::Name& destRouter);
+  switchToBackupNextHops(const ndn::FaceUri& faceUri);
 
   /*! \brief Schedules a calculation event in the event scheduler only
    *  if one isn't already scheduled.
+   *
+   *  Calculations are throttled with an exponential backoff, as in IS-IS and OSPF: the first
+   *  change after a quiet period is calculated after the initial wait. While changes keep
+   *  coming, the wait starts at the increment and doubles up to the routing calculation
+   *  interval. The wait is reset when a change arrives at least twice the current wait after
+   *  the last calculation started.
    */
   void
   scheduleRoutingTableCalculation();
 
 private:
-  /*! \brief Calculates a link-state routing table. */
+  /*! \brief Calculates a link-state routing table into \p rt . */
   void
-  calculateLsRoutingTable();
+  calculateLsRoutingTable(const LsdbSnapshot& lsdb, RoutingTableStatus& rt);
 
-  /*! \brief Calculates a HR routing table. */
+  /*! \brief Calculates a HR routing table into \p rt . */
   void
-  calculateHypRoutingTable(bool isDryRun);
+  calculateHypRoutingTable(const LsdbSnapshot& lsdb, RoutingTableStatus& rt, bool isDryRun);
+
+  /*! \brief Replaces the calculated tables with those of \p result and announces the changes.
+   *  \param isLinkState Whether a link-state table was calculated.
+   *  \param isHyperbolic Whether a HR table was calculated.
+   */
+  void
+  installRoutingTable(RoutingTableStatus&& result, bool isLinkState, bool isHyperbolic);
+
+  /*! \brief Determines the wait before the next calculation and advances the backoff. */
+  ndn::time::milliseconds
+  getRoutingCalcDelay();
+
+  /*! \brief Discards the result of the calculation in flight, if any.
+   *
+   *  The caller schedules the calculation that replaces it.
+   */
+  void
+  cancelCalculation();
+
+  /*! \brief Records the processing time and load index of \p lsa .
+   *  \return Whether they differ from those of the previous version.
+   */
+  bool
+  updateNameLsaMetrics(const NameLsa& lsa, LsdbUpdate updateType);
 
   void
   clearRoutingTable();
@@ -144,13 +213,21 @@ private:
 
 public:
   AfterRoutingChange afterRoutingChange;
+  ndn::signal::Signal<RoutingTable, Statistics::PacketType> rtIncrementSignal;
 
 private:
   ndn::Scheduler& m_scheduler;
+  boost::asio::io_context& m_io;
   Lsdb& m_lsdb;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Maximum wait before a calculation. */
   ndn::time::seconds m_routingCalcInterval;
+  ndn::time::milliseconds m_routingCalcInitialWait;
+  ndn::time::milliseconds m_routingCalcIncrement;
+  /*! \brief Wait applied to the next change while changes keep coming. */
+  ndn::time::milliseconds m_routingCalcHoldTime{0};
+  ndn::time::steady_clock::time_point m_lastRoutingCalcTime;
   bool m_isRoutingTableCalculating;
   bool m_isRouteCalculationScheduled;
 
@@ -158,6 +235,28 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::signal::Connection m_afterLsdbModified;
   int32_t m_hyperbolicState;
   bool m_ownAdjLsaExist = false;
+
+  /*! \brief Worker threads for the routing calculation; absent when configured with one thread. */
+  std::unique_ptr<boost::asio::thread_pool> m_workerPool;
+  /*! \brief Thread running asynchronous calculations; absent when they are disabled. */
+  std::unique_ptr<boost::asio::thread_pool> m_calculationThread;
+  /*! \brief Set to discard the result of the calculation in flight; null when there is none. */
+  std::shared_ptr<std::atomic<bool>> m_isCalculationCancelled;
+  /*! \brief Routers whose Name LSA metrics changed since the last calculation started. */
+  std::set<ndn::Name> m_changedNameLsas;
+  /*! \brief Processing time and load index of each Name LSA in the LSDB. */
+  std::map<ndn::Name, std::pair<double, double>> m_nameLsaMetrics;
+  /*! \brief Routers whose Coordinate LSA changed since the last calculation started. */
+  std::set<ndn::Name> m_changedCoordinateLsas;
+  /*! \brief Router costs and shortest path trees of the previous link-state calculation.
+   *
+   *  Only the calculation in flight uses it.
+   */
+  LinkStateCache m_linkStateCache;
+  /*! \brief Distances of the previous hyperbolic calculation; only the calculation in flight
+   *  uses it.
+   */
+  HyperbolicCache m_hyperbolicCache;
 };
 
 } // namespace nlsr
@@ -0,0 +1,454 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shortest-path.hpp"
+#include "adjacent.hpp"
+
+#include <boost/heap/d_ary_heap.hpp>
+
+#include <limits>
+
+namespace nlsr {
+namespace {
+
+struct QueueEntry
+{
+  double distance;
+  uint32_t hops;
+  int router;
+  size_t firstHopIndex = 0;
+};
+
+/**
+ * @brief Orders queue entries so that the heap top is the closest router.
+ *
+ * Boost.Heap containers are max-heaps, hence the reversed comparison.
+ */
+struct QueueEntryCompare
+{
+  bool
+  operator()(const QueueEntry& lhs, const QueueEntry& rhs) const
+  {
+    return std::tie(lhs.distance, lhs.hops, lhs.router, lhs.firstHopIndex) >
+           std::tie(rhs.distance, rhs.hops, rhs.router, rhs.firstHopIndex);
+  }
+};
+
+using RouterQueue = boost::heap::d_ary_heap<QueueEntry,
+                                            boost::heap::arity<2>,
+                                            boost::heap::mutable_<true>,
+                                            boost::heap::compare<QueueEntryCompare>>;
+
+bool
+isShorter(double distance, uint32_t hops, double otherDistance, uint32_t otherHops)
+{
+  return std::tie(distance, hops) < std::tie(otherDistance, otherHops);
+}
+
+/**
+ * @brief Whether a tree restricted to @p firstHop may use the link from @p u to @p v .
+ */
+bool
+isUsable(int u, int v, int sourceRouter, int firstHop)
+{
+  return u != sourceRouter || firstHop == NO_NEXT_HOP || v == firstHop;
+}
+
+DijkstraResult
+makeEmptyTree(size_t nRouters, int sourceRouter)
+{
+  DijkstraResult tree;
+  tree.parent.assign(nRouters, EMPTY_PARENT);
+  tree.distance.assign(nRouters, INF_DISTANCE);
+  tree.hops.assign(nRouters, 0);
+  tree.firstHop.assign(nRouters, NO_NEXT_HOP);
+  tree.distance[sourceRouter] = 0;
+  return tree;
+}
+
+/**
+ * @brief Recompute the first hop of every router from the parent links of @p tree .
+ */
+void
+assignFirstHops(DijkstraResult& tree, int sourceRouter)
+{
+  size_t nRouters = tree.parent.size();
+  std::vector<std::vector<int>> children(nRouters);
+  for (size_t v = 0; v < nRouters; ++v) {
+    if (tree.parent[v] != EMPTY_PARENT) {
+      children[tree.parent[v]].push_back(v);
+    }
+  }
+
+  std::vector<int> stack{sourceRouter};
+  while (!stack.empty()) {
+    int u = stack.back();
+    stack.pop_back();
+    for (int v : children[u]) {
+      tree.firstHop[v] = u == sourceRouter ? v : tree.firstHop[u];
+      stack.push_back(v);
+    }
+  }
+}
+
+} // anonymous namespace
+
+DijkstraResult
+calculateDijkstraPath(const TopologyGraph& graph, int sourceRouter,
+                      const std::vector<double>& nodeCost)
+{
+  size_t nRouters = graph.size();
+
+  DijkstraResult result = makeEmptyTree(nRouters, sourceRouter);
+  auto& parent = result.parent;
+  auto& distance = result.distance;
+  auto& hops = result.hops;
+  auto& firstHop = result.firstHop;
+
+  std::vector<bool> isExplored(nRouters, false);
+  std::vector<RouterQueue::handle_type> handles(nRouters);
+  std::vector<bool> isQueued(nRouters, false);
+
+  RouterQueue queue;
+  queue.reserve(nRouters);
+
+  handles[sourceRouter] = queue.push(QueueEntry{0, 0, sourceRouter});
+  isQueued[sourceRouter] = true;
+
+  while (!queue.empty()) {
+    int u = queue.top().router;
+    queue.pop();
+    isExplored[u] = true;
+
+    for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+      int v = graph.getNeighbor(link);
+      if (isExplored[v]) {
+        continue;
+      }
+
+      double linkCost = graph.getCost(link) + nodeCost[v];
+      double newDistance = distance[u] + linkCost;
+      uint32_t newHops = hops[u] + 1;
+      if (isShorter(newDistance, newHops, distance[v], hops[v])) {
+        distance[v] = newDistance;
+        hops[v] = newHops;
+        parent[v] = u;
+        // u is settled, so its first hop is final
+        firstHop[v] = u == sourceRouter ? v : firstHop[u];
+        if (isQueued[v]) {
+          queue.increase(handles[v], QueueEntry{newDistance, newHops, v});
+        }
+        else {
+          handles[v] = queue.push(QueueEntry{newDistance, newHops, v});
+          isQueued[v] = true;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+MultipathDijkstraResult
+calculateMultipathDijkstraPath(const TopologyGraph& graph, int sourceRouter,
+                               const std::vector<double>& nodeCost,
+                               const std::vector<int>& firstHops)
+{
+  size_t nRouters = graph.size();
+  size_t nStates = firstHops.size() * nRouters;
+
+  MultipathDijkstraResult result;
+  result.firstHops = firstHops;
+  result.trees.assign(firstHops.size(), makeEmptyTree(nRouters, sourceRouter));
+
+  // A state is a (router, first hop) pair, stored at firstHopIndex * nRouters + router
+  std::vector<bool> isExplored(nStates, false);
+  std::vector<RouterQueue::handle_type> handles(nStates);
+  std::vector<bool> isQueued(nStates, false);
+
+  RouterQueue queue;
+  queue.reserve(nStates);
+
+  auto relax = [&] (size_t firstHopIndex, int u, int v, double linkCost) {
+    size_t state = firstHopIndex * nRouters + v;
+    auto& tree = result.trees[firstHopIndex];
+    double newDistance = tree.distance[u] + linkCost;
+    uint32_t newHops = tree.hops[u] + 1;
+    if (isExplored[state] || !isShorter(newDistance, newHops, tree.distance[v], tree.hops[v])) {
+      return;
+    }
+    tree.distance[v] = newDistance;
+    tree.hops[v] = newHops;
+    tree.parent[v] = u;
+    tree.firstHop[v] = firstHops[firstHopIndex];
+    if (isQueued[state]) {
+      queue.increase(handles[state], QueueEntry{newDistance, newHops, v, firstHopIndex});
+    }
+    else {
+      handles[state] = queue.push(QueueEntry{newDistance, newHops, v, firstHopIndex});
+      isQueued[state] = true;
+    }
+  };
+
+  for (size_t k = 0; k < firstHops.size(); ++k) {
+    isExplored[k * nRouters + sourceRouter] = true;
+    // The source is settled; its only usable link is the one to the k-th first hop
+    double linkCost = graph.getLinkCost(sourceRouter, firstHops[k]);
+    if (linkCost != Adjacent::NON_ADJACENT_COST) {
+      relax(k, sourceRouter, firstHops[k], linkCost + nodeCost[firstHops[k]]);
+    }
+  }
+
+  while (!queue.empty()) {
+    int u = queue.top().router;
+    size_t k = queue.top().firstHopIndex;
+    queue.pop();
+    isExplored[k * nRouters + u] = true;
+
+    for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+      int v = graph.getNeighbor(link);
+      relax(k, u, v, graph.getCost(link) + nodeCost[v]);
+    }
+  }
+
+  return result;
+}
+
+std::vector<LinkChange>
+diffTopology(const TopologyGraph& oldGraph, const TopologyGraph& newGraph,
+             const std::vector<double>& oldNodeCost, const std::vector<double>& newNodeCost)
+{
+  BOOST_ASSERT(oldGraph.size() == newGraph.size());
+  constexpr int32_t END = std::numeric_limits<int32_t>::max();
+
+  std::vector<LinkChange> changes;
+  for (int32_t u = 0; u < static_cast<int32_t>(newGraph.size()); ++u) {
+    // Both rows are sorted by neighbor, so they can be merged
+    size_t i = oldGraph.linksBegin(u);
+    size_t j = newGraph.linksBegin(u);
+    while (i < oldGraph.linksEnd(u) || j < newGraph.linksEnd(u)) {
+      int32_t oldNeighbor = i < oldGraph.linksEnd(u) ? oldGraph.getNeighbor(i) : END;
+      int32_t newNeighbor = j < newGraph.linksEnd(u) ? newGraph.getNeighbor(j) : END;
+      int32_t v = std::min(oldNeighbor, newNeighbor);
+
+      double oldCost = INF_DISTANCE;
+      if (oldNeighbor == v) {
+        oldCost = oldGraph.getCost(i++) + oldNodeCost[v];
+      }
+      double newCost = INF_DISTANCE;
+      if (newNeighbor == v) {
+        newCost = newGraph.getCost(j++) + newNodeCost[v];
+      }
+
+      if (oldCost != newCost) {
+        changes.push_back({u, v, oldCost, newCost});
+      }
+    }
+  }
+  return changes;
+}
+
+size_t
+updateDijkstraPath(DijkstraResult& tree, const TopologyGraph& graph,
+                   const std::vector<double>& nodeCost, const std::vector<LinkChange>& changes,
+                   int sourceRouter, int firstHop)
+{
+  size_t nRouters = graph.size();
+  auto& parent = tree.parent;
+  auto& distance = tree.distance;
+  auto& hops = tree.hops;
+
+  // Routers below a link whose cost increased lose their paths
+  std::vector<bool> isAffected(nRouters, false);
+  std::vector<int> affected;
+  std::vector<std::vector<int>> children;
+  for (const auto& change : changes) {
+    if (change.to == sourceRouter || parent[change.to] != change.from ||
+        !(change.newCost > change.oldCost) || isAffected[change.to] ||
+        !isUsable(change.from, change.to, sourceRouter, firstHop)) {
+      continue;
+    }
+
+    if (children.empty()) {
+      children.resize(nRouters);
+      for (size_t v = 0; v < nRouters; ++v) {
+        if (parent[v] != EMPTY_PARENT) {
+          children[parent[v]].push_back(v);
+        }
+      }
+    }
+
+    std::vector<int> stack{change.to};
+    isAffected[change.to] = true;
+    while (!stack.empty()) {
+      int v = stack.back();
+      stack.pop_back();
+      affected.push_back(v);
+      for (int child : children[v]) {
+        if (!isAffected[child]) {
+          isAffected[child] = true;
+          stack.push_back(child);
+        }
+      }
+    }
+  }
+
+  for (int v : affected) {
+    parent[v] = EMPTY_PARENT;
+    distance[v] = INF_DISTANCE;
+    hops[v] = 0;
+    tree.firstHop[v] = NO_NEXT_HOP;
+  }
+
+  std::vector<bool> isExplored(nRouters, false);
+  std::vector<RouterQueue::handle_type> handles(nRouters);
+  std::vector<bool> isQueued(nRouters, false);
+  RouterQueue queue;
+
+  // Offer @p v the path through @p u . Among equally good paths, keep the parent that
+  // calculateDijkstraPath would have settled first.
+  bool isFirstHopStale = false;
+  auto offer = [&] (int u, int v, double linkCost) {
+    double newDistance = distance[u] + linkCost;
+    uint32_t newHops = hops[u] + 1;
+    int newFirstHop = u == sourceRouter ? v : tree.firstHop[u];
+    if (isShorter(newDistance, newHops, distance[v], hops[v])) {
+      distance[v] = newDistance;
+      hops[v] = newHops;
+      parent[v] = u;
+      tree.firstHop[v] = newFirstHop;
+      if (isQueued[v]) {
+        queue.increase(handles[v], QueueEntry{newDistance, newHops, v});
+      }
+      else {
+        handles[v] = queue.push(QueueEntry{newDistance, newHops, v});
+        isQueued[v] = true;
+      }
+    }
+    else if (newDistance == distance[v] && newHops == hops[v] && parent[v] != EMPTY_PARENT &&
+             std::tie(distance[u], hops[u], u) <
+             std::tie(distance[parent[v]], hops[parent[v]], parent[v])) {
+      parent[v] = u;
+      // Routers below v keep their paths and are not revisited, so their first hops
+      // must be fixed afterwards
+      isFirstHopStale = isFirstHopStale || tree.firstHop[v] != newFirstHop;
+      tree.firstHop[v] = newFirstHop;
+    }
+  };
+
+  // Give each affected router its best path through the unaffected part of the tree.
+  // Links are symmetric, so the cost of a link from v also applies toward v.
+  for (int v : affected) {
+    for (size_t link = graph.linksBegin(v); link < graph.linksEnd(v); ++link) {
+      int u = graph.getNeighbor(link);
+      if (!isAffected[u] && distance[u] != INF_DISTANCE &&
+          isUsable(u, v, sourceRouter, firstHop)) {
+        offer(u, v, graph.getCost(link) + nodeCost[v]);
+      }
+    }
+  }
+
+  // Links whose cost decreased may offer shorter paths
+  for (const auto& change : changes) {
+    if (change.newCost < change.oldCost && change.to != sourceRouter &&
+        !isAffected[change.from] && distance[change.from] != INF_DISTANCE &&
+        isUsable(change.from, change.to, sourceRouter, firstHop)) {
+      offer(change.from, change.to, change.newCost);
+    }
+  }
+
+  size_t nUpdated = 0;
+  while (!queue.empty()) {
+    int u = queue.top().router;
+    queue.pop();
+    isExplored[u] = true;
+    ++nUpdated;
+
+    for (size_t link = graph.linksBegin(u); link < graph.linksEnd(u); ++link) {
+      int v = graph.getNeighbor(link);
+      if (v != sourceRouter && !isExplored[v] && isUsable(u, v, sourceRouter, firstHop)) {
+        offer(u, v, graph.getCost(link) + nodeCost[v]);
+      }
+    }
+  }
+
+  // Affected routers that are no longer reachable were not visited by the search
+  for (int v : affected) {
+    if (distance[v] == INF_DISTANCE) {
+      ++nUpdated;
+    }
+  }
+
+  if (isFirstHopStale) {
+    assignFirstHops(tree, sourceRouter);
+  }
+  return nUpdated;
+}
+
+std::vector<int>
+calculateLoopFreeAlternates(const TopologyGraph& graph, int sourceRouter,
+                            const std::vector<double>& nodeCost, const DijkstraResult& primary,
+                            const std::vector<int>& neighbors,
+                            const std::vector<DijkstraResult>& neighborTrees)
+{
+  BOOST_ASSERT(neighbors.size() == neighborTrees.size());
+  size_t nRouters = graph.size();
+
+  std::vector<int> treeIndex(nRouters, NO_NEXT_HOP);
+  std::vector<double> neighborCost(neighbors.size());
+  for (size_t k = 0; k < neighbors.size(); ++k) {
+    treeIndex[neighbors[k]] = k;
+    neighborCost[k] = graph.getLinkCost(sourceRouter, neighbors[k]) + nodeCost[neighbors[k]];
+  }
+
+  std::vector<int> alternates(nRouters, NO_NEXT_HOP);
+  for (size_t dest = 0; dest < nRouters; ++dest) {
+    int primaryHop = primary.firstHop[dest];
+    if (primaryHop == NO_NEXT_HOP) {
+      continue;
+    }
+    const DijkstraResult* primaryTree = treeIndex[primaryHop] == NO_NEXT_HOP ?
+                                        nullptr : &neighborTrees[treeIndex[primaryHop]];
+
+    bool isBestNodeProtecting = false;
+    double bestDistance = INF_DISTANCE;
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      const auto& tree = neighborTrees[k];
+      if (neighbors[k] == primaryHop || tree.distance[dest] == INF_DISTANCE ||
+          !(tree.distance[dest] < tree.distance[sourceRouter] + primary.distance[dest])) {
+        continue;
+      }
+
+      bool isNodeProtecting = static_cast<int>(dest) != primaryHop && primaryTree != nullptr &&
+                              tree.distance[dest] <
+                              tree.distance[primaryHop] + primaryTree->distance[dest];
+      double distance = neighborCost[k] + tree.distance[dest];
+      if (isNodeProtecting != isBestNodeProtecting ? isNodeProtecting : distance < bestDistance) {
+        alternates[dest] = neighbors[k];
+        isBestNodeProtecting = isNodeProtecting;
+        bestDistance = distance;
+      }
+    }
+  }
+  return alternates;
+}
+
+} // namespace nlsr
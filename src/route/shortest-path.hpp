@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_SHORTEST_PATH_HPP
+#define NLSR_ROUTE_SHORTEST_PATH_HPP
+
+#include "common.hpp"
+#include "topology-graph.hpp"
+
+namespace nlsr {
+
+inline constexpr int EMPTY_PARENT = -12345;
+inline constexpr double INF_DISTANCE = 2147483647;
+inline constexpr int NO_NEXT_HOP = -12345;
+
+/**
+ * @brief Shortest path tree rooted at a source router.
+ *
+ * All vectors are indexed by NameMap mapping number. Paths are compared by distance, then by
+ * hop count; among equally good paths, each router's parent is the one that comes first in
+ * (distance, hop count, mapping number) order. This makes the tree a function of the topology
+ * alone, so that a tree repaired by updateDijkstraPath equals one computed from scratch.
+ *
+ * The original calculation took whichever equal-cost parent its re-sorted queue reached first,
+ * so the next hop toward a router with several equal-cost paths may differ from it; distances,
+ * and next hops where only one path is shortest, are the same.
+ */
+class DijkstraResult
+{
+public:
+  /**
+   * @brief Return the first hop on the path from the source to @p dest .
+   * @return Mapping number of the first hop, or @c NO_NEXT_HOP if @p dest is the source or
+   *         is unreachable.
+   */
+  int
+  getNextHop(int dest) const
+  {
+    return firstHop[dest];
+  }
+
+public:
+  std::vector<int> parent;
+  std::vector<double> distance;
+  std::vector<uint32_t> hops;
+  /// First hop toward each router, recorded when the router's path is found
+  std::vector<int> firstHop;
+};
+
+/**
+ * @brief Shortest path trees from a source router through each of a set of first hops.
+ *
+ * Tree @c k contains, for every router, the shortest path that leaves the source through
+ * @c firstHops[k] and does not return to the source.
+ */
+class MultipathDijkstraResult
+{
+public:
+  double
+  getDistance(size_t firstHopIndex, int dest) const
+  {
+    return trees[firstHopIndex].distance[dest];
+  }
+
+  /**
+   * @brief Determine the first hop for @p dest when leaving through @c firstHops[firstHopIndex] .
+   * @return Mapping number of the first hop, or @c NO_NEXT_HOP if @p dest cannot be reached
+   *         through it.
+   */
+  int
+  getNextHop(size_t firstHopIndex, int dest) const
+  {
+    return trees[firstHopIndex].getNextHop(dest);
+  }
+
+public:
+  std::vector<int> firstHops;
+  std::vector<DijkstraResult> trees;
+};
+
+/**
+ * @brief A change in the cost of reaching router @c to over its link from router @c from .
+ *
+ * Costs include the cost of entering @c to ; a missing link has cost @c INF_DISTANCE .
+ */
+struct LinkChange
+{
+  int32_t from;
+  int32_t to;
+  double oldCost;
+  double newCost;
+};
+
+/**
+ * @brief Compute the shortest path from a source router to every other router.
+ * @param graph Router topology.
+ * @param sourceRouter Mapping number of the source router.
+ * @param nodeCost Additional cost of entering each router, indexed by mapping number.
+ *
+ * Routers are settled in order of increasing distance using an addressable binary heap with
+ * decrease-key, so a calculation takes O((N + E) log N).
+ */
+DijkstraResult
+calculateDijkstraPath(const TopologyGraph& graph, int sourceRouter,
+                      const std::vector<double>& nodeCost);
+
+/**
+ * @brief Compute, in a single pass, the shortest paths through each neighbor of the source.
+ * @param graph Router topology.
+ * @param sourceRouter Mapping number of the source router.
+ * @param nodeCost Additional cost of entering each router, indexed by mapping number.
+ * @param firstHops Mapping numbers of neighbors of @p sourceRouter .
+ *
+ * The result for each first hop equals that of a separate Dijkstra run in which the source
+ * router's link to that neighbor is its only link. Instead of running the algorithm once per
+ * neighbor, the search runs over (router, first hop) pairs sharing one queue, so the topology
+ * is traversed in one pass and no per-neighbor setup is needed.
+ */
+MultipathDijkstraResult
+calculateMultipathDijkstraPath(const TopologyGraph& graph, int sourceRouter,
+                               const std::vector<double>& nodeCost,
+                               const std::vector<int>& firstHops);
+
+/**
+ * @brief List the link costs that differ between two topologies of the same routers.
+ * @param oldGraph Previous topology.
+ * @param newGraph Current topology; mapping numbers must denote the same routers.
+ * @param oldNodeCost Previous cost of entering each router.
+ * @param newNodeCost Current cost of entering each router.
+ *
+ * A changed cost of entering a router changes every link toward it.
+ */
+std::vector<LinkChange>
+diffTopology(const TopologyGraph& oldGraph, const TopologyGraph& newGraph,
+             const std::vector<double>& oldNodeCost, const std::vector<double>& newNodeCost);
+
+/**
+ * @brief Repair a shortest path tree after some link costs have changed.
+ * @param tree Tree computed on the previous topology; updated in place.
+ * @param graph Current topology.
+ * @param nodeCost Current cost of entering each router.
+ * @param changes Link costs that differ from the previous topology, see diffTopology.
+ * @param sourceRouter Mapping number of the source router.
+ * @param firstHop If not @c NO_NEXT_HOP , the tree is one of a MultipathDijkstraResult, in
+ *                 which the source only uses its link to this neighbor.
+ * @return Number of routers whose path was recomputed.
+ *
+ * This is a dynamic shortest path algorithm in the style of Ramalingam and Reps. Routers below
+ * a link whose cost increased lose their paths, and are given the best path through the rest
+ * of the tree. Those routers, as well as the far ends of links whose cost decreased, seed a
+ * Dijkstra search that stops wherever paths no longer improve. Routers outside the affected
+ * part of the tree are not visited, unless an equal-cost parent change moves them to another
+ * first hop.
+ */
+size_t
+updateDijkstraPath(DijkstraResult& tree, const TopologyGraph& graph,
+                   const std::vector<double>& nodeCost, const std::vector<LinkChange>& changes,
+                   int sourceRouter, int firstHop = NO_NEXT_HOP);
+
+/**
+ * @brief Choose a loop-free alternate (LFA) next hop toward every router, as in RFC 5286.
+ * @param graph Router topology.
+ * @param sourceRouter Mapping number of the source router.
+ * @param nodeCost Additional cost of entering each router, indexed by mapping number.
+ * @param primary Shortest paths from @p sourceRouter ; only distance and firstHop are used.
+ * @param neighbors Mapping numbers of neighbors of @p sourceRouter .
+ * @param neighborTrees Shortest path tree rooted at each of @p neighbors .
+ * @return Mapping number of the alternate neighbor toward each router, or @c NO_NEXT_HOP if
+ *         there is none.
+ *
+ * Neighbor N is an alternate toward D if its shortest path to D does not go back through the
+ * source: `dist(N, D) < dist(N, S) + dist(S, D)`. Alternates that also avoid the primary next
+ * hop E, `dist(N, D) < dist(N, E) + dist(E, D)`, are preferred, then the ones with the
+ * shortest path through them.
+ */
+std::vector<int>
+calculateLoopFreeAlternates(const TopologyGraph& graph, int sourceRouter,
+                            const std::vector<double>& nodeCost, const DijkstraResult& primary,
+                            const std::vector<int>& neighbors,
+                            const std::vector<DijkstraResult>& neighborTrees);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_SHORTEST_PATH_HPP
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "topology-graph.hpp"
+#include "adjacent.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace nlsr {
+
+INIT_LOGGER(route.TopologyGraph);
+
+TopologyGraph
+TopologyGraph::createFromAnnouncedLinks(size_t nRouters, std::vector<AnnouncedLink> links)
+{
+  auto byEndpoints = [] (const AnnouncedLink& lhs, const AnnouncedLink& rhs) {
+    return std::tie(lhs.from, lhs.to) < std::tie(rhs.from, rhs.to);
+  };
+
+  // Sort by endpoints; stable so that the last announcement of a duplicate link comes last.
+  std::stable_sort(links.begin(), links.end(), byEndpoints);
+
+  auto findCost = [&] (int32_t from, int32_t to) {
+    AnnouncedLink key{from, to, 0};
+    auto it = std::upper_bound(links.begin(), links.end(), key, byEndpoints);
+    if (it == links.begin() || (it - 1)->from != from || (it - 1)->to != to) {
+      return Adjacent::NON_ADJACENT_COST;
+    }
+    return (it - 1)->cost;
+  };
+
+  TopologyGraph graph;
+  graph.m_offsets.assign(nRouters + 1, 0);
+  graph.m_neighbors.reserve(links.size());
+  graph.m_costs.reserve(links.size());
+
+  for (auto it = links.begin(); it != links.end(); ++it) {
+    // Skip all but the last announcement of a duplicate link, and links to itself
+    if ((it + 1 != links.end() && (it + 1)->from == it->from && (it + 1)->to == it->to) ||
+        it->from == it->to) {
+      continue;
+    }
+    BOOST_ASSERT(static_cast<size_t>(it->from) < nRouters &&
+                 static_cast<size_t>(it->to) < nRouters);
+
+    double toCost = it->cost;
+    double fromCost = findCost(it->to, it->from);
+    double correctedCost = toCost;
+
+    // Links that do not have the same cost for both directions should have their costs
+    // corrected. If the cost of one side of the link is NON_ADJACENT_COST (i.e. broken)
+    // or negative, both directions of the link are broken. Otherwise, both sides of the
+    // link use the larger of the two costs.
+    if (fromCost != toCost) {
+      correctedCost = Adjacent::NON_ADJACENT_COST;
+      if (toCost >= 0 && fromCost >= 0) {
+        correctedCost = std::max(toCost, fromCost);
+      }
+
+      // Each mismatch is seen from both sides unless one side is missing; log it only once
+      if (it->from < it->to || fromCost == Adjacent::NON_ADJACENT_COST) {
+        NLSR_LOG_WARN("Cost between [" << it->from << "][" << it->to << "] and [" << it->to <<
+                      "][" << it->from << "] are not the same (" << toCost << " != " <<
+                      fromCost << "). " << "Correcting to cost: " << correctedCost);
+      }
+    }
+
+    if (correctedCost == Adjacent::NON_ADJACENT_COST) {
+      continue;
+    }
+
+    ++graph.m_offsets[it->from + 1];
+    graph.m_neighbors.push_back(it->to);
+    graph.m_costs.push_back(correctedCost);
+  }
+
+  // Turn per-router link counts into offsets
+  std::partial_sum(graph.m_offsets.begin(), graph.m_offsets.end(), graph.m_offsets.begin());
+
+  return graph;
+}
+
+double
+TopologyGraph::getLinkCost(int32_t from, int32_t to) const
+{
+  auto first = m_neighbors.begin() + linksBegin(from);
+  auto last = m_neighbors.begin() + linksEnd(from);
+  auto it = std::lower_bound(first, last, to);
+  if (it == last || *it != to) {
+    return Adjacent::NON_ADJACENT_COST;
+  }
+  return m_costs[it - m_neighbors.begin()];
+}
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyGraph& graph)
+{
+  os << "-----------Topology (index: neighbor(cost) ...)------\n";
+  for (size_t i = 0; i < graph.size(); ++i) {
+    os << i << ":";
+    for (size_t link = graph.linksBegin(i); link < graph.linksEnd(i); ++link) {
+      os << " " << graph.getNeighbor(link) << "(" << graph.getCost(link) << ")";
+    }
+    os << "\n";
+  }
+  return os;
+}
+
+} // namespace nlsr
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_TOPOLOGY_GRAPH_HPP
+#define NLSR_ROUTE_TOPOLOGY_GRAPH_HPP
+
+#include "common.hpp"
+#include "name-map.hpp"
+#include "lsa/adj-lsa.hpp"
+
+#include <boost/concept_check.hpp>
+
+namespace nlsr {
+
+/**
+ * @brief Router topology in compressed sparse row (CSR) form.
+ *
+ * Routers are identified by their NameMap mapping numbers. The links leaving router @c i are
+ * stored contiguously at positions `[linksBegin(i), linksEnd(i))` of the neighbor and cost
+ * arrays, sorted by neighbor mapping number. Memory use is O(N+E), as opposed to the O(N^2)
+ * of an adjacency matrix.
+ *
+ * Only links whose costs have been reconciled in both directions are present, so the graph is
+ * always symmetric.
+ */
+class TopologyGraph
+{
+public:
+  /**
+   * @brief A link as announced in the Adjacency LSA of router @c from .
+   */
+  struct AnnouncedLink
+  {
+    int32_t from;
+    int32_t to;
+    double cost;
+  };
+
+  TopologyGraph() = default;
+
+  /**
+   * @brief Create a TopologyGraph from Adjacency LSAs.
+   * @tparam IteratorType A *LegacyInputIterator* whose value type is convertible to
+   *                      `std::shared_ptr<AdjLsa>`.
+   * @param first Range begin iterator.
+   * @param last Range past-end iterator. It must be reachable by incrementing @p first .
+   * @param map NameMap that contains every origin and adjacent router name in the range.
+   */
+  template<typename IteratorType>
+  static TopologyGraph
+  createFromAdjLsdb(IteratorType first, IteratorType last, const NameMap& map)
+  {
+    BOOST_CONCEPT_ASSERT((boost::InputIterator<IteratorType>));
+    std::vector<AnnouncedLink> links;
+    for (auto it = first; it != last; ++it) {
+      // *it has type std::shared_ptr<Lsa> ; it->get() has type Lsa*
+      auto lsa = static_cast<const AdjLsa*>(it->get());
+      auto from = map.getMappingNoByRouterName(lsa->getOriginRouter());
+      if (!from) {
+        continue;
+      }
+      for (const auto& adjacent : lsa->getAdl().getAdjList()) {
+        auto to = map.getMappingNoByRouterName(adjacent.getName());
+        if (to) {
+          links.push_back({*from, *to, adjacent.getLinkCost()});
+        }
+      }
+    }
+    return createFromAnnouncedLinks(map.size(), std::move(links));
+  }
+
+  /**
+   * @brief Create a TopologyGraph from announced links.
+   * @param nRouters Number of routers; mapping numbers must be less than this value.
+   * @param links Links announced by each router. If a router announces the same link more
+   *              than once, the last announcement wins.
+   *
+   * Links that do not have the same cost in both directions have their costs corrected:
+   * if either side is @c Adjacent::NON_ADJACENT_COST (i.e. broken), missing, or negative,
+   * the link is left out; otherwise, both directions use the larger of the two costs.
+   */
+  static TopologyGraph
+  createFromAnnouncedLinks(size_t nRouters, std::vector<AnnouncedLink> links);
+
+  /**
+   * @brief Return number of routers.
+   */
+  size_t
+  size() const
+  {
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+  }
+
+  /**
+   * @brief Return number of directed links.
+   */
+  size_t
+  getNLinks() const
+  {
+    return m_neighbors.size();
+  }
+
+  size_t
+  linksBegin(int32_t router) const
+  {
+    return m_offsets[router];
+  }
+
+  size_t
+  linksEnd(int32_t router) const
+  {
+    return m_offsets[router + 1];
+  }
+
+  int32_t
+  getNeighbor(size_t link) const
+  {
+    return m_neighbors[link];
+  }
+
+  double
+  getCost(size_t link) const
+  {
+    return m_costs[link];
+  }
+
+  /**
+   * @brief Find the cost of the link from @p from to @p to .
+   * @return Link cost, or @c Adjacent::NON_ADJACENT_COST if there is no such link.
+   */
+  double
+  getLinkCost(int32_t from, int32_t to) const;
+
+private:
+  std::vector<size_t> m_offsets;
+  std::vector<int32_t> m_neighbors;
+  std::vector<double> m_costs;
+
+  friend std::ostream&
+  operator<<(std::ostream& os, const TopologyGraph& graph);
+};
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyGraph& graph);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_TOPOLOGY_GRAPH_HPP
@@ -29,10 +29,10 @@
 namespace nlsr {
 
 class RoutingTable;
-class RoutingTableEntry;
+class RoutingTableDiff;
 class SyncLogicHandler;
 
-using AfterRoutingChange = ndn::signal::Signal<RoutingTable, std::list<RoutingTableEntry>>;
+using AfterRoutingChange = ndn::signal::Signal<RoutingTable, RoutingTableDiff>;
 using OnNewLsa = ndn::signal::Signal<SyncLogicHandler, ndn::Name, uint64_t, ndn::Name, uint64_t>;
 
 } // namespace nlsr
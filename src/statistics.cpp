@@ -38,9 +38,9 @@ Statistics::get(PacketType type) const
 }
 
 void
-Statistics::increment(PacketType type)
+Statistics::increment(PacketType type, size_t count)
 {
-  m_packetCounter[type]++;
+  m_packetCounter[type] += count;
 }
 
 void
@@ -90,6 +90,15 @@ operator<<(std::ostream& os, const Statistics& stats)
      << "    Received Adjacency LSA Data: "       << stats.get(PacketType::RCV_ADJ_LSA_DATA) << "\n"
      << "    Received Coordinate LSA Data: "      << stats.get(PacketType::RCV_COORD_LSA_DATA) << "\n"
      << "    Received Name LSA Data: "            << stats.get(PacketType::RCV_NAME_LSA_DATA) << "\n"
+     << "    Received Name LSA Deltas: "          << stats.get(PacketType::RCV_NAME_LSA_DELTA) << "\n"
+     << "\n"
+     << "    Signed LSA Segments: "               << stats.get(PacketType::SIGNED_LSA_SEGMENT) << "\n"
+     << "    Coalesced LSA Fetches: "             << stats.get(PacketType::LSA_FETCH_COALESCED) << "\n"
+     << "    Superseded LSA Fetches: "            << stats.get(PacketType::LSA_FETCH_SUPERSEDED) << "\n"
+     << "\n"
+     << "ROUTING TABLE\n"
+     << "    Scheduled Calculations: "            << stats.get(PacketType::ROUTING_CALC_SCHEDULED) << "\n"
+     << "    Saved Calculations: "                << stats.get(PacketType::ROUTING_CALC_SAVED) << "\n"
      << "++++++++++++++++++++++++++++++++++++++++\n";
 
   return os;
@@ -50,14 +50,21 @@ public:
     RCV_LSA_DATA,
     RCV_ADJ_LSA_DATA,
     RCV_COORD_LSA_DATA,
-    RCV_NAME_LSA_DATA
+    RCV_NAME_LSA_DATA,
+    RCV_NAME_LSA_DELTA,
+    /// Total since start or reset; sample it periodically to get the signing rate
+    SIGNED_LSA_SEGMENT,
+    LSA_FETCH_COALESCED,
+    LSA_FETCH_SUPERSEDED,
+    ROUTING_CALC_SCHEDULED,
+    ROUTING_CALC_SAVED
   };
 
   size_t
   get(PacketType) const;
 
   void
-  increment(PacketType);
+  increment(PacketType, size_t count = 1);
 
   void
   resetAll();
@@ -23,20 +23,28 @@
 
 namespace nlsr {
 
-StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
+StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& rt)
   : m_lsdb(lsdb)
   , m_hp(hp)
+  , m_rt(rt)
 {
   m_lsaIncrementConn = m_lsdb.lsaIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                                    this, _1));
   m_helloIncrementConn = m_hp.hpIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                                   this, _1));
+  m_rtIncrementConn = m_rt.rtIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
+                                                               this, _1));
+  m_segmentsSignedConn = m_lsdb.afterSegmentsSigned.connect([this] (size_t nSegments) {
+    m_stats.increment(Statistics::PacketType::SIGNED_LSA_SEGMENT, nSegments);
+  });
 }
 
 StatsCollector::~StatsCollector()
 {
   m_lsaIncrementConn.disconnect();
   m_helloIncrementConn.disconnect();
+  m_rtIncrementConn.disconnect();
+  m_segmentsSignedConn.disconnect();
 }
 
 void
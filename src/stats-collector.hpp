@@ -24,6 +24,7 @@
 #include "statistics.hpp"
 #include "lsdb.hpp"
 #include "hello-protocol.hpp"
+#include "route/routing-table.hpp"
 #include <ndn-cxx/util/signal.hpp>
 
 namespace nlsr {
@@ -35,7 +36,7 @@ class StatsCollector
 {
 public:
 
-  StatsCollector(Lsdb& lsdb, HelloProtocol& hp);
+  StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& rt);
 
   ~StatsCollector();
 
@@ -62,10 +63,13 @@ private:
 
   Lsdb& m_lsdb;
   HelloProtocol& m_hp;
+  RoutingTable& m_rt;
   Statistics m_stats;
 
   ndn::signal::ScopedConnection m_lsaIncrementConn;
   ndn::signal::ScopedConnection m_helloIncrementConn;
+  ndn::signal::ScopedConnection m_rtIncrementConn;
+  ndn::signal::ScopedConnection m_segmentsSignedConn;
 };
 
 } // namespace nlsr
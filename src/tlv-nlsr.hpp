@@ -55,7 +55,10 @@ enum {
   Cost = 150,
   NextHop = 151,
   RoutingTable = 152,
-  RoutingTableEntry = 153
+  RoutingTableEntry = 153,
+  NameLsaDelta = 154,
+  BaseSequenceNumber = 155,
+  NameLsaNoDelta = 156
 };
 
 } // namespace tlv
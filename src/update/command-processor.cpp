@@ -21,9 +21,13 @@
 
 #include "command-processor.hpp"
 #include "logger.hpp"
+#include "prefix-update-commands.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 
+#include <algorithm>
+#include <set>
+
 namespace nlsr::update {
 
 INIT_LOGGER(update.CommandProcessor);
@@ -53,7 +57,7 @@ CommandProcessor::advertiseAndInsertPrefix(const ndn::mgmt::ControlParametersBas
   double castParamCost = (castParams.hasCost() ? castParams.getCost() : 0);
   if (m_namePrefixList.insert(castParams.getName(), "", castParamCost)) {
     NLSR_LOG_INFO("Advertising name: " << castParams.getName());
-    m_lsdb.buildAndInstallOwnNameLsa();
+    m_lsdb.scheduleNameLsaBuild();
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
       NLSR_LOG_INFO("Saving name to the configuration file ");
       auto [afterAdvertiseReturn, afterAdvertiseMessage] = afterAdvertise(castParams.getName());
@@ -98,7 +102,7 @@ CommandProcessor::withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase
   // Only build a Name LSA if the added name is new
   if (m_namePrefixList.erase(castParams.getName())) {
     NLSR_LOG_INFO("Withdrawing/Removing name: " << castParams.getName());
-    m_lsdb.buildAndInstallOwnNameLsa();
+    m_lsdb.scheduleNameLsaBuild();
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
       auto [afterWithdrawReturn, afterWithdrawMessage] = afterWithdraw(castParams.getName());
       if (afterWithdrawReturn) {
@@ -129,4 +133,98 @@ CommandProcessor::withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase
   }
 }
 
+void
+CommandProcessor::advertiseAndInsertPrefixList(const ndn::mgmt::ControlParametersBase& parameters,
+                                               const ndn::mgmt::CommandContinuation& done)
+{
+  updatePrefixList(static_cast<const PrefixListParameters&>(parameters), true, done);
+}
+
+void
+CommandProcessor::withdrawAndRemovePrefixList(const ndn::mgmt::ControlParametersBase& parameters,
+                                              const ndn::mgmt::CommandContinuation& done)
+{
+  updatePrefixList(static_cast<const PrefixListParameters&>(parameters), false, done);
+}
+
+void
+CommandProcessor::updatePrefixList(const PrefixListParameters& parameters, bool isAdvertise,
+                                   const ndn::mgmt::CommandContinuation& done)
+{
+  bool wantSave = parameters.hasFlags() && parameters.getFlags() == PREFIX_FLAG;
+  auto body = parameters.wireEncode();
+
+  // A name listed more than once is applied once, with the last cost given for it
+  std::vector<PrefixInfo> prefixes;
+  std::set<ndn::Name> names;
+  for (auto it = parameters.getPrefixes().rbegin(); it != parameters.getPrefixes().rend(); ++it) {
+    if (names.insert(it->getName()).second) {
+      prefixes.push_back(*it);
+    }
+  }
+  std::reverse(prefixes.begin(), prefixes.end());
+
+  // Save first, so that a failure leaves both the saved and the advertised prefixes as they were.
+  // Prefixes that are already saved, or already not saved, are left alone.
+  if (wantSave) {
+    std::vector<ndn::Name> toSave;
+    for (const auto& prefix : prefixes) {
+      if (isSaved(prefix.getName()) != isAdvertise) {
+        toSave.push_back(prefix.getName());
+      }
+    }
+
+    for (auto it = toSave.begin(); it != toSave.end(); ++it) {
+      auto [isDone, message] = isAdvertise ? afterAdvertise(*it) : afterWithdraw(*it);
+      if (isDone) {
+        continue;
+      }
+
+      NLSR_LOG_WARN("Cannot save " << *it << ", rolling back the prefix list");
+      for (auto savedIt = toSave.begin(); savedIt != it; ++savedIt) {
+        isAdvertise ? afterWithdraw(*savedIt) : afterAdvertise(*savedIt);
+      }
+      return done(ndn::nfd::ControlResponse(500, "Prefix " + it->toUri() +
+                                                 " not saved, no prefix applied: " + message)
+                  .setBody(body));
+    }
+  }
+
+  size_t nChanged = 0;
+  for (const auto& prefix : prefixes) {
+    bool isChanged = false;
+    if (isAdvertise) {
+      // A new cost for an advertised prefix changes the Name LSA as well
+      bool isCostChanged = m_namePrefixList.contains(prefix.getName()) &&
+                           m_namePrefixList.getPrefixInfoForName(prefix.getName()).getCost() !=
+                             prefix.getCost();
+      isChanged = m_namePrefixList.insert(prefix.getName(), "", prefix.getCost()) || isCostChanged;
+    }
+    else {
+      isChanged = m_namePrefixList.erase(prefix.getName());
+    }
+
+    if (isChanged) {
+      NLSR_LOG_INFO((isAdvertise ? "Advertising name: " : "Withdrawing/Removing name: ")
+                    << prefix.getName());
+      ++nChanged;
+    }
+  }
+
+  // The list is applied as a whole: one Name LSA is built for all of its changes
+  if (nChanged > 0) {
+    m_lsdb.scheduleNameLsaBuild();
+  }
+
+  if (wantSave) {
+    return done(ndn::nfd::ControlResponse(205, "OK").setBody(body));
+  }
+  if (nChanged == 0) {
+    std::string message = isAdvertise ? "Prefixes are already advertised/inserted."
+                                      : "Prefixes are already withdrawn/removed.";
+    return done(ndn::nfd::ControlResponse(204, message).setBody(body));
+  }
+  return done(ndn::nfd::ControlResponse(200, "OK").setBody(body));
+}
+
 } // namespace nlsr::update
@@ -33,6 +33,8 @@
 
 namespace nlsr::update {
 
+class PrefixListParameters;
+
 enum { PREFIX_FLAG = 1 };
 
 class CommandProcessor : boost::noncopyable
@@ -65,6 +67,24 @@ public:
   withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase& parameters,
                           const ndn::mgmt::CommandContinuation& done);
 
+  /*! \brief Add every prefix of a PrefixListParameters to the advertised name prefix list.
+   *
+   * The whole list is applied before the Name LSA is rebuilt, so a request originates one
+   * Name LSA however many prefixes it carries. A new cost for an advertised prefix counts as
+   * a change. A name listed more than once is applied once. When the prefixes are to be
+   * saved, those not saved yet are saved before any is applied, and if one cannot be saved
+   * the others are unsaved again and the list is left unchanged.
+   */
+  void
+  advertiseAndInsertPrefixList(const ndn::mgmt::ControlParametersBase& parameters,
+                               const ndn::mgmt::CommandContinuation& done);
+
+  /*! \brief Remove every prefix of a PrefixListParameters from the advertised name prefix list.
+   */
+  void
+  withdrawAndRemovePrefixList(const ndn::mgmt::ControlParametersBase& parameters,
+                              const ndn::mgmt::CommandContinuation& done);
+
   /*! \brief Processing after advertise command delegated to subclass.
    *         This is always treated as successful if not implemented.
    *  \return tuple {bool indicating success/failure, message string}.
@@ -85,6 +105,20 @@ public:
     return {true, "OK"};
   }
 
+  /*! \brief Whether a prefix is saved, delegated to subclass.
+   *         No prefix is saved if not implemented.
+   */
+  virtual bool
+  isSaved(const ndn::Name& prefix)
+  {
+    return false;
+  }
+
+private:
+  void
+  updatePrefixList(const PrefixListParameters& parameters, bool isAdvertise,
+                   const ndn::mgmt::CommandContinuation& done);
+
 protected:
   ndn::mgmt::Dispatcher& m_dispatcher;
   NamePrefixList& m_namePrefixList;
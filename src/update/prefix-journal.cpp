@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "prefix-journal.hpp"
+#include "logger.hpp"
+
+#include <filesystem>
+
+namespace nlsr::update {
+
+INIT_LOGGER(update.PrefixJournal);
+
+PrefixJournal::PrefixJournal(std::string fileName)
+  : m_fileName(std::move(fileName))
+{
+}
+
+void
+PrefixJournal::load()
+{
+  m_output.close();
+  m_prefixes.clear();
+  m_nRecords = 0;
+
+  std::ifstream input(m_fileName);
+  if (!input.is_open()) {
+    NLSR_LOG_DEBUG("No prefix journal at " << m_fileName);
+    return;
+  }
+
+  bool hasMalformedRecords = false;
+  std::string line;
+  while (std::getline(input, line)) {
+    // A record without its newline was being written when the writer stopped
+    if (input.eof() ||
+        line.size() < 3 || (line[0] != '+' && line[0] != '-') || line[1] != ' ') {
+      NLSR_LOG_WARN("Skipping malformed record in " << m_fileName << ": " << line);
+      hasMalformedRecords = true;
+      continue;
+    }
+
+    ndn::Name prefix;
+    try {
+      prefix = ndn::Name(line.substr(2));
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_WARN("Skipping malformed record in " << m_fileName << ": " << e.what());
+      hasMalformedRecords = true;
+      continue;
+    }
+
+    if (line[0] == '+') {
+      m_prefixes.insert(prefix);
+    }
+    else {
+      m_prefixes.erase(prefix);
+    }
+    ++m_nRecords;
+  }
+  input.close();
+
+  NLSR_LOG_DEBUG("Loaded " << m_prefixes.size() << " saved prefixes from " << m_nRecords <<
+                 " records in " << m_fileName);
+
+  // Records appended after a malformed one must start on a line of their own
+  if (hasMalformedRecords) {
+    try {
+      compact();
+    }
+    catch (const Error& e) {
+      NLSR_LOG_ERROR(e.what());
+    }
+  }
+}
+
+bool
+PrefixJournal::add(const ndn::Name& prefix)
+{
+  if (!m_prefixes.insert(prefix).second) {
+    return false;
+  }
+
+  try {
+    append('+', prefix);
+  }
+  catch (const Error&) {
+    m_prefixes.erase(prefix);
+    throw;
+  }
+  return true;
+}
+
+bool
+PrefixJournal::remove(const ndn::Name& prefix)
+{
+  if (m_prefixes.erase(prefix) == 0) {
+    return false;
+  }
+
+  try {
+    append('-', prefix);
+  }
+  catch (const Error&) {
+    m_prefixes.insert(prefix);
+    throw;
+  }
+  return true;
+}
+
+void
+PrefixJournal::append(char operation, const ndn::Name& prefix)
+{
+  if (!m_output.is_open()) {
+    m_output.open(m_fileName, std::ios::app);
+  }
+
+  m_output << operation << ' ' << prefix << '\n' << std::flush;
+  if (!m_output) {
+    m_output.close();
+    NDN_THROW(Error("Failed to write the prefix journal " + m_fileName));
+  }
+  ++m_nRecords;
+
+  if (m_nRecords >= COMPACTION_MIN_RECORDS && m_nRecords > 2 * m_prefixes.size()) {
+    // The record is already written, so a failed compaction only leaves the journal longer
+    try {
+      compact();
+    }
+    catch (const Error& e) {
+      NLSR_LOG_ERROR(e.what());
+    }
+  }
+}
+
+void
+PrefixJournal::compact()
+{
+  m_output.close();
+
+  std::string tempPath = m_fileName + ".tmp";
+  std::ofstream output(tempPath, std::ios::trunc);
+  for (const auto& prefix : m_prefixes) {
+    output << "+ " << prefix << '\n';
+  }
+  output.close();
+  if (!output) {
+    NDN_THROW(Error("Failed to write the prefix journal " + tempPath));
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, m_fileName, ec);
+  if (ec) {
+    NDN_THROW(Error("Failed to replace the prefix journal " + m_fileName + ": " + ec.message()));
+  }
+
+  NLSR_LOG_DEBUG("Compacted " << m_fileName << " from " << m_nRecords << " to " <<
+                 m_prefixes.size() << " records");
+  m_nRecords = m_prefixes.size();
+}
+
+} // namespace nlsr::update
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_UPDATE_PREFIX_JOURNAL_HPP
+#define NLSR_UPDATE_PREFIX_JOURNAL_HPP
+
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/name.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <fstream>
+#include <unordered_set>
+
+namespace nlsr::update {
+
+/*! \brief Append-only journal of the name prefixes saved by prefix update commands.
+ *
+ * Saving or deleting a prefix appends one record to the journal file, "+ <name>" or
+ * "- <name>", and the saved prefixes are kept in a hash set, so that neither a command nor
+ * a membership check reads the file. Once the file holds more than twice as many records as
+ * there are saved prefixes, it is compacted: the saved prefixes are written to a temporary
+ * file, which then replaces the journal.
+ *
+ * The journal is kept next to the dynamic configuration file, and its prefixes are
+ * advertised at startup along with those of the \c advertising section.
+ *
+ * \sa makePrefixJournalFileName
+ */
+class PrefixJournal : boost::noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  explicit
+  PrefixJournal(std::string fileName);
+
+  const std::string&
+  getFileName() const
+  {
+    return m_fileName;
+  }
+
+  /*! \brief Read the saved prefixes from the journal file.
+   *
+   * A missing file is an empty journal. Malformed records, such as the last record of a
+   * journal whose writer was interrupted, are skipped.
+   */
+  void
+  load();
+
+  bool
+  contains(const ndn::Name& prefix) const
+  {
+    return m_prefixes.count(prefix) > 0;
+  }
+
+  const std::unordered_set<ndn::Name>&
+  getPrefixes() const
+  {
+    return m_prefixes;
+  }
+
+  /*! \brief Save \p prefix .
+   *  \retval false \p prefix is already saved; the journal is unchanged.
+   *  \throw Error The record cannot be written.
+   */
+  bool
+  add(const ndn::Name& prefix);
+
+  /*! \brief Delete \p prefix .
+   *  \retval false \p prefix is not saved; the journal is unchanged.
+   *  \throw Error The record cannot be written.
+   */
+  bool
+  remove(const ndn::Name& prefix);
+
+  /*! \brief Rewrite the journal with one record per saved prefix.
+   *  \throw Error The journal cannot be written.
+   */
+  void
+  compact();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  size_t
+  getRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+private:
+  void
+  append(char operation, const ndn::Name& prefix);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// The journal is not compacted while it holds fewer records than this
+  static constexpr size_t COMPACTION_MIN_RECORDS = 64;
+
+private:
+  std::string m_fileName;
+  std::unordered_set<ndn::Name> m_prefixes;
+  size_t m_nRecords = 0;
+  std::ofstream m_output;
+};
+
+/*! \brief Return the name of the prefix journal kept next to the dynamic configuration file
+ *         \p confFileNameDynamic .
+ */
+inline std::string
+makePrefixJournalFileName(const std::string& confFileNameDynamic)
+{
+  return confFileNameDynamic + ".journal";
+}
+
+} // namespace nlsr::update
+
+#endif // NLSR_UPDATE_PREFIX_JOURNAL_HPP
@@ -20,6 +20,11 @@
  */
 
 #include "prefix-update-commands.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv-nfd.hpp>
 
 namespace nlsr::update {
 
@@ -41,4 +46,111 @@ const WithdrawPrefixCommand::ResponseFormat WithdrawPrefixCommand::s_responseFor
     .required(ndn::nfd::CONTROL_PARAMETER_NAME)
     .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
 
+template<ndn::encoding::Tag TAG>
+size_t
+PrefixListParameters::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  if (m_flags) {
+    totalLength += ndn::encoding::prependNonNegativeIntegerBlock(encoder, ndn::nfd::tlv::Flags,
+                                                                  *m_flags);
+  }
+
+  for (auto it = m_prefixes.rbegin(); it != m_prefixes.rend(); ++it) {
+    totalLength += it->wireEncode(encoder);
+  }
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(ndn::nfd::tlv::ControlParameters);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(PrefixListParameters);
+
+ndn::Block
+PrefixListParameters::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+void
+PrefixListParameters::wireDecode(const ndn::Block& wire)
+{
+  if (wire.type() != ndn::nfd::tlv::ControlParameters) {
+    NDN_THROW(Error("ControlParameters", wire.type()));
+  }
+
+  m_wire = wire;
+  m_wire.parse();
+  m_prefixes.clear();
+  m_flags.reset();
+
+  auto val = m_wire.elements_begin();
+  for (; val != m_wire.elements_end() && val->type() == nlsr::tlv::PrefixInfo; ++val) {
+    m_prefixes.emplace_back(*val);
+  }
+
+  if (val != m_wire.elements_end() && val->type() == ndn::nfd::tlv::Flags) {
+    m_flags = ndn::encoding::readNonNegativeInteger(*val);
+    ++val;
+  }
+
+  if (val != m_wire.elements_end()) {
+    NDN_THROW(Error("Unexpected TLV-TYPE " + std::to_string(val->type()) +
+                    " in PrefixListParameters"));
+  }
+}
+
+void
+PrefixListCommandFormat::validate(const PrefixListParameters& parameters) const
+{
+  if (parameters.getPrefixes().empty()) {
+    NDN_THROW(ndn::nfd::ArgumentError("Prefix list is empty"));
+  }
+
+  for (const auto& prefix : parameters.getPrefixes()) {
+    if (prefix.getCost() < 0) {
+      NDN_THROW(ndn::nfd::ArgumentError("Negative cost for " + prefix.getName().toUri()));
+    }
+  }
+}
+
+std::shared_ptr<PrefixListParameters>
+PrefixListCommandFormat::decode(const ndn::Interest& interest, size_t prefixLen)
+{
+  if (interest.hasApplicationParameters()) {
+    return std::make_shared<PrefixListParameters>(
+      interest.getApplicationParameters().blockFromValue());
+  }
+
+  auto block = interest.getName().at(prefixLen).blockFromValue();
+  return std::make_shared<PrefixListParameters>(block);
+}
+
+void
+PrefixListCommandFormat::encode(ndn::Interest& interest, const PrefixListParameters& parameters)
+{
+  interest.setApplicationParameters(parameters.wireEncode());
+}
+
+const AdvertisePrefixListCommand::RequestFormat AdvertisePrefixListCommand::s_requestFormat;
+const AdvertisePrefixListCommand::ResponseFormat AdvertisePrefixListCommand::s_responseFormat;
+
+const WithdrawPrefixListCommand::RequestFormat WithdrawPrefixListCommand::s_requestFormat;
+const WithdrawPrefixListCommand::ResponseFormat WithdrawPrefixListCommand::s_responseFormat;
+
 } // namespace nlsr::update
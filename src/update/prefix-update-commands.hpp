@@ -34,8 +34,13 @@
 #ifndef NLSR_UPDATE_PREFIX_UPDATE_COMMANDS_HPP
 #define NLSR_UPDATE_PREFIX_UPDATE_COMMANDS_HPP
 
+#include "name-prefix-list.hpp"
+
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace nlsr::update {
 
 class AdvertisePrefixCommand : public ndn::nfd::ControlCommand<AdvertisePrefixCommand>
@@ -48,6 +53,126 @@ class WithdrawPrefixCommand : public ndn::nfd::ControlCommand<WithdrawPrefixComm
   NDN_CXX_CONTROL_COMMAND("prefix-update", "withdraw");
 };
 
+/*! \brief Parameters of commands that advertise or withdraw a list of name prefixes.
+ *
+ * ControlParameters carries a single Name, so the bulk commands use their own parameters:
+ *
+ *     PrefixListParameters = CONTROL-PARAMETERS-TYPE TLV-LENGTH
+ *                              1*PrefixInfo
+ *                              [Flags]
+ *
+ * Each PrefixInfo holds a name and its cost; the cost is ignored when withdrawing.
+ */
+class PrefixListParameters : public ndn::mgmt::ControlParametersBase
+{
+public:
+  class Error : public ndn::tlv::Error
+  {
+  public:
+    using ndn::tlv::Error::Error;
+  };
+
+  PrefixListParameters() = default;
+
+  explicit
+  PrefixListParameters(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<PrefixInfo>&
+  getPrefixes() const
+  {
+    return m_prefixes;
+  }
+
+  PrefixListParameters&
+  addPrefix(const ndn::Name& name, double cost = 0)
+  {
+    m_prefixes.emplace_back(name, cost);
+    m_wire.reset();
+    return *this;
+  }
+
+  bool
+  hasFlags() const
+  {
+    return m_flags.has_value();
+  }
+
+  uint64_t
+  getFlags() const
+  {
+    return m_flags.value_or(0);
+  }
+
+  PrefixListParameters&
+  setFlags(uint64_t flags)
+  {
+    m_flags = flags;
+    m_wire.reset();
+    return *this;
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& encoder) const;
+
+  ndn::Block
+  wireEncode() const final;
+
+  void
+  wireDecode(const ndn::Block& wire) final;
+
+private:
+  std::vector<PrefixInfo> m_prefixes;
+  std::optional<uint64_t> m_flags;
+
+  mutable ndn::Block m_wire;
+};
+
+/*! \brief Format of the bulk prefix update commands.
+ *
+ * The parameters are carried in the ApplicationParameters of a signed Interest, so that the
+ * name stays short and the rest of the packet is left for the list. For compatibility, they
+ * are also accepted as the name component that follows the command verb, as with
+ * ControlParametersCommandFormat.
+ */
+class PrefixListCommandFormat
+{
+public:
+  using ParametersType = PrefixListParameters;
+
+  /*! \throw ndn::nfd::ArgumentError The list is empty or contains a negative cost.
+   */
+  void
+  validate(const PrefixListParameters& parameters) const;
+
+  static std::shared_ptr<PrefixListParameters>
+  decode(const ndn::Interest& interest, size_t prefixLen = 0);
+
+  static void
+  encode(ndn::Interest& interest, const PrefixListParameters& parameters);
+};
+
+/*! \brief Advertise all prefixes of a PrefixListParameters in one request.
+ */
+class AdvertisePrefixListCommand
+  : public ndn::nfd::ControlCommand<AdvertisePrefixListCommand,
+                                    PrefixListCommandFormat, PrefixListCommandFormat>
+{
+  NDN_CXX_CONTROL_COMMAND("prefix-update", "advertise-list");
+};
+
+/*! \brief Withdraw all prefixes of a PrefixListParameters in one request.
+ */
+class WithdrawPrefixListCommand
+  : public ndn::nfd::ControlCommand<WithdrawPrefixListCommand,
+                                    PrefixListCommandFormat, PrefixListCommandFormat>
+{
+  NDN_CXX_CONTROL_COMMAND("prefix-update", "withdraw-list");
+};
+
 } // namespace nlsr::update
 
 #endif // NLSR_UPDATE_PREFIX_UPDATE_COMMANDS_HPP
@@ -23,9 +23,6 @@
 #include "logger.hpp"
 #include "prefix-update-commands.hpp"
 
-#include <boost/algorithm/string.hpp>
-#include <fstream>
-
 namespace nlsr::update {
 
 INIT_LOGGER(update.PrefixUpdateProcessor);
@@ -65,6 +62,15 @@ PrefixUpdateProcessor::PrefixUpdateProcessor(ndn::mgmt::Dispatcher& dispatcher,
     makeAuthorization(),
     // the first and second arguments are ignored since the handler does not need them
     std::bind(&PrefixUpdateProcessor::withdrawAndRemovePrefix, this, _3, _4));
+
+  // A list is validated once, however many prefixes it carries
+  m_dispatcher.addControlCommand<AdvertisePrefixListCommand>(
+    makeAuthorization(),
+    std::bind(&PrefixUpdateProcessor::advertiseAndInsertPrefixList, this, _3, _4));
+
+  m_dispatcher.addControlCommand<WithdrawPrefixListCommand>(
+    makeAuthorization(),
+    std::bind(&PrefixUpdateProcessor::withdrawAndRemovePrefixList, this, _3, _4));
 }
 
 ndn::mgmt::Authorization
@@ -96,75 +102,44 @@ PrefixUpdateProcessor::loadValidator(boost::property_tree::ptree section,
   m_validator.load(section, filename);
 }
 
-bool
-PrefixUpdateProcessor::checkForPrefixInFile(const std::string prefix)
+PrefixJournal&
+PrefixUpdateProcessor::getJournal()
 {
-  std::string line;
-  std::fstream fp(m_confFileNameDynamic);
-  if (!fp.good() || !fp.is_open()) {
-    NLSR_LOG_ERROR("Failed to open configuration file for parsing");
-    return true;
+  auto fileName = makePrefixJournalFileName(m_confFileNameDynamic);
+  if (m_journal == nullptr || m_journal->getFileName() != fileName) {
+    m_journal = std::make_unique<PrefixJournal>(fileName);
+    m_journal->load();
   }
-  while (!fp.eof()) {
-    getline(fp, line);
-    if (line == prefix) {
-      return true;
-    }
-  }
-  return false;
+  return *m_journal;
 }
 
 std::tuple<bool, std::string>
 PrefixUpdateProcessor::addOrDeletePrefix(const ndn::Name& prefix, bool addPrefix)
 {
-  std::string value = " prefix " + prefix.toUri();
-  std::string fileString;
-  std::string line;
-  std::string trimedLine;
-  std::fstream input(m_confFileNameDynamic, input.in);
-  if (!input.good() || !input.is_open()) {
-    NLSR_LOG_ERROR("Failed to open configuration file for parsing");
-    return {false, "Failed to open configuration file for parsing"};
+  if (m_confFileNameDynamic.empty()) {
+    NLSR_LOG_ERROR("No state directory to save prefixes in");
+    return {false, "No state directory to save prefixes in"};
   }
 
-  if (addPrefix) {
-    //check if prefix already exist in the nlsr configuration file
-    if (checkForPrefixInFile(value)) {
-      NLSR_LOG_ERROR("Prefix already exists in the configuration file");
-      return {false, "Prefix already exists in the configuration file"};
-    }
-    while (!input.eof()) {
-      getline(input, line);
-      if (!line.empty()) {
-        fileString.append(line + "\n");
-        if (line == "advertising") {
-          getline(input, line);
-          fileString.append(line + "\n" + value + "\n");
-        }
+  try {
+    auto& journal = getJournal();
+    if (addPrefix) {
+      if (!journal.add(prefix)) {
+        NLSR_LOG_ERROR("Prefix is already saved");
+        return {false, "Prefix is already saved"};
       }
     }
-  }
-  else {
-    if (!checkForPrefixInFile(value)) {
-      NLSR_LOG_ERROR("Prefix doesn't exists in the configuration file");
-      return {false, "Prefix doesn't exists in the configuration file"};
-    }
-    boost::trim(value);
-    while (!input.eof()) {
-      getline(input, line);
-      if (!line.empty()) {
-        std::string trimLine = line;
-        boost::trim(trimLine);
-        if (trimLine != value) {
-          fileString.append(line + "\n");
-        }
+    else {
+      if (!journal.remove(prefix)) {
+        NLSR_LOG_ERROR("Prefix is not saved");
+        return {false, "Prefix is not saved"};
       }
     }
   }
-  input.close();
-  std::ofstream output(m_confFileNameDynamic);
-  output << fileString;
-  output.close();
+  catch (const PrefixJournal::Error& e) {
+    NLSR_LOG_ERROR(e.what());
+    return {false, e.what()};
+  }
   return {true, "OK"};
 }
 
@@ -180,4 +155,20 @@ PrefixUpdateProcessor::afterWithdraw(const ndn::Name& prefix)
   return addOrDeletePrefix(prefix, false);
 }
 
+bool
+PrefixUpdateProcessor::isSaved(const ndn::Name& prefix)
+{
+  if (m_confFileNameDynamic.empty()) {
+    return false;
+  }
+
+  try {
+    return getJournal().contains(prefix);
+  }
+  catch (const PrefixJournal::Error& e) {
+    NLSR_LOG_ERROR(e.what());
+    return false;
+  }
+}
+
 } // namespace nlsr::update
@@ -23,6 +23,7 @@
 #define NLSR_UPDATE_PREFIX_UPDATE_PROCESSOR_HPP
 
 #include "command-processor.hpp"
+#include "prefix-journal.hpp"
 
 #include <ndn-cxx/security/key-chain.hpp>
 
@@ -54,27 +55,36 @@ public:
   void
   loadValidator(ConfigSection section, const std::string& filename);
 
-  /*! \brief Add or delete an advertise or withdrawn prefix to the nlsr
-   * configuration file
+  /*! \brief Add or delete an advertise or withdrawn prefix to the saved prefixes
+   * \sa PrefixJournal
    */
   std::tuple<bool, std::string>
   addOrDeletePrefix(const ndn::Name& prefix, bool addPrefix);
 
-  /*! \brief Save an advertised prefix to the nlsr configuration file.
+  /*! \brief Save an advertised prefix to the prefix journal.
    *  \return tuple {bool indicating success/failure, message string}.
    */
   std::tuple<bool, std::string>
   afterAdvertise(const ndn::Name& prefix) override;
 
-  /*! \brief Remove an advertised prefix from the nlsr configuration file.
+  /*! \brief Remove an advertised prefix from the prefix journal.
    *  \return tuple {bool indicating success/failure, message string}.
    */
   std::tuple<bool, std::string>
   afterWithdraw(const ndn::Name& prefix) override;
 
-  /*! \brief Check if a prefix exists in the nlsr configuration file */
+  /*! \brief Whether a prefix is in the prefix journal.
+   */
   bool
-  checkForPrefixInFile(const std::string prefix);
+  isSaved(const ndn::Name& prefix) override;
+
+  /*! \brief Return the journal of saved prefixes, loading it on first use.
+   *
+   * The dynamic configuration file is known only once the configuration is processed, so the
+   * journal is opened on demand, and reopened if that file changes.
+   */
+  PrefixJournal&
+  getJournal();
 
   ndn::security::ValidatorConfig&
   getValidator()
@@ -95,6 +105,7 @@ private:
 private:
   ndn::security::ValidatorConfig& m_validator;
   const std::string& m_confFileNameDynamic;
+  std::unique_ptr<PrefixJournal> m_journal;
 };
 
 } // namespace nlsr::update
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nlsr::util {
+
+void
+TimerWheel::EventId::cancel() const
+{
+  auto entry = m_entry.lock();
+  if (entry && entry->callback) {
+    entry->callback = nullptr;
+    --*entry->nPending;
+    if (entry->slot != nullptr) {
+      entry->slot->erase(entry->position);
+      entry->slot = nullptr;
+    }
+  }
+}
+
+TimerWheel::EventId::operator bool() const
+{
+  auto entry = m_entry.lock();
+  return entry && entry->callback;
+}
+
+TimerWheel::TimerWheel(ndn::Scheduler& scheduler, ndn::time::nanoseconds tick)
+  : m_scheduler(scheduler)
+  , m_tick(tick)
+  , m_epoch(ndn::time::steady_clock::now())
+{
+}
+
+TimerWheel::EventId
+TimerWheel::schedule(ndn::time::nanoseconds after, ndn::scheduler::EventCallback callback)
+{
+  auto now = ndn::time::steady_clock::now();
+  if (!m_isTicking) {
+    // The wheel is empty, so it can skip the ticks that went by while it was idle
+    m_current = std::max(m_current, getElapsedTicks(now));
+    m_isTicking = true;
+    scheduleTick();
+  }
+
+  // Round up, so that the event does not fire early
+  auto sinceEpoch = std::max(now + after - m_epoch, ndn::time::steady_clock::duration::zero());
+  uint64_t tick = (sinceEpoch + m_tick - ndn::time::nanoseconds(1)) / m_tick;
+  auto entry = std::make_shared<Entry>(Entry{std::max(tick, m_current + 1), std::move(callback),
+                                             m_nPending});
+  ++*m_nPending;
+  insert(entry);
+  return EventId(entry);
+}
+
+uint64_t
+TimerWheel::getElapsedTicks(const ndn::time::steady_clock::time_point& now) const
+{
+  return now > m_epoch ? static_cast<uint64_t>((now - m_epoch) / m_tick) : 0;
+}
+
+void
+TimerWheel::insert(std::shared_ptr<Entry> entry)
+{
+  uint64_t delta = entry->tick - m_current;
+  size_t level = 0;
+  while (level < N_LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  // Events beyond the range of the wheel wait in the top level and are placed again when
+  // that slot comes up
+  uint64_t tick = std::min(entry->tick, m_current + (uint64_t{1} << (SLOT_BITS * N_LEVELS)) - 1);
+  auto& slot = m_levels[level][(tick >> (SLOT_BITS * level)) & (N_SLOTS - 1)];
+  auto* entryPtr = entry.get();
+  entryPtr->position = slot.insert(slot.end(), std::move(entry));
+  entryPtr->slot = &slot;
+}
+
+TimerWheel::Slot
+TimerWheel::takeSlot(Slot& slot)
+{
+  Slot taken;
+  taken.swap(slot);
+  for (const auto& entry : taken) {
+    entry->slot = nullptr;
+  }
+  return taken;
+}
+
+void
+TimerWheel::onTick()
+{
+  auto target = getElapsedTicks(ndn::time::steady_clock::now());
+  while (m_current < target && *m_nPending > 0) {
+    advance();
+  }
+
+  if (*m_nPending > 0) {
+    scheduleTick();
+  }
+  else {
+    m_isTicking = false;
+  }
+}
+
+void
+TimerWheel::advance()
+{
+  ++m_current;
+
+  // When a level wraps around, spread the next slot of the level above over the lower levels
+  for (size_t level = 1; level < N_LEVELS; ++level) {
+    if ((m_current & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) != 0) {
+      break;
+    }
+    auto cascaded = takeSlot(m_levels[level][(m_current >> (SLOT_BITS * level)) & (N_SLOTS - 1)]);
+    for (auto& entry : cascaded) {
+      if (entry->callback) {
+        insert(std::move(entry));
+      }
+    }
+  }
+
+  auto due = takeSlot(m_levels[0][m_current & (N_SLOTS - 1)]);
+  for (auto& entry : due) {
+    if (entry->callback && entry->tick > m_current) {
+      insert(std::move(entry));
+    }
+  }
+
+  // Run the whole batch; an event may still cancel another one of the same tick
+  for (const auto& entry : due) {
+    if (entry && entry->callback) {
+      auto callback = std::move(entry->callback);
+      entry->callback = nullptr;
+      --*m_nPending;
+      callback();
+    }
+  }
+}
+
+void
+TimerWheel::scheduleTick()
+{
+  auto next = m_epoch + m_tick * static_cast<int64_t>(m_current + 1);
+  auto delay = std::max(next - ndn::time::steady_clock::now(),
+                        ndn::time::steady_clock::duration::zero());
+  m_tickEvent = m_scheduler.schedule(delay, [this] { onTick(); });
+}
+
+} // namespace nlsr::util
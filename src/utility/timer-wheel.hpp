@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TIMER_WHEEL_HPP
+#define NLSR_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <list>
+#include <utility>
+
+namespace nlsr::util {
+
+/**
+ * @brief Hierarchical timing wheel for coarse-grained timeouts.
+ *
+ * LSA expirations, LSA segment evictions and FIB entry refreshes are counted in seconds and
+ * there are tens of thousands of them in a large network. Instead of giving each one its own
+ * ndn::Scheduler event, the wheel keeps them in buckets of one tick and uses a single scheduler
+ * event per tick; all events due in a tick are run as one batch. Events that are further away
+ * sit in coarser levels of the wheel and are moved down as their time approaches, so
+ * scheduling and cancelling take constant time. A cancelled event is removed from its slot
+ * right away, so it does not hold memory until that slot comes round.
+ *
+ * An event never fires before its delay has elapsed, and fires at most one tick after. While
+ * no event is pending, the wheel does not schedule ticks.
+ */
+class TimerWheel : boost::noncopyable
+{
+private:
+  struct Entry;
+  using Slot = std::list<std::shared_ptr<Entry>>;
+
+  struct Entry
+  {
+    /// Tick in which the event is due
+    uint64_t tick;
+    /// Empty once the event has fired or has been cancelled
+    ndn::scheduler::EventCallback callback;
+    /// Number of pending events of the wheel, shared so that handles may outlive the wheel
+    std::shared_ptr<size_t> nPending;
+    /// Slot that holds the entry; null while the wheel is moving it
+    Slot* slot = nullptr;
+    /// Position of the entry in #slot
+    Slot::iterator position;
+  };
+
+public:
+  /**
+   * @brief Handle of an event scheduled in a TimerWheel.
+   */
+  class EventId
+  {
+  public:
+    EventId() = default;
+
+    /**
+     * @brief Cancel the event; does nothing if it has already fired or been cancelled.
+     */
+    void
+    cancel() const;
+
+    /**
+     * @brief Return whether the event is still pending.
+     */
+    explicit
+    operator bool() const;
+
+  private:
+    explicit
+    EventId(const std::shared_ptr<Entry>& entry)
+      : m_entry(entry)
+    {
+    }
+
+  private:
+    std::weak_ptr<Entry> m_entry;
+
+    friend TimerWheel;
+  };
+
+  /**
+   * @brief Event handle that cancels its event when destroyed or reassigned.
+   */
+  class ScopedEventId : boost::noncopyable
+  {
+  public:
+    ScopedEventId() = default;
+
+    ScopedEventId(const EventId& eventId)
+      : m_eventId(eventId)
+    {
+    }
+
+    ScopedEventId(ScopedEventId&& other) noexcept
+      : m_eventId(std::exchange(other.m_eventId, EventId()))
+    {
+    }
+
+    ScopedEventId&
+    operator=(ScopedEventId&& other) noexcept
+    {
+      if (this != &other) {
+        m_eventId.cancel();
+        m_eventId = std::exchange(other.m_eventId, EventId());
+      }
+      return *this;
+    }
+
+    ScopedEventId&
+    operator=(const EventId& eventId)
+    {
+      m_eventId.cancel();
+      m_eventId = eventId;
+      return *this;
+    }
+
+    ~ScopedEventId()
+    {
+      m_eventId.cancel();
+    }
+
+    void
+    cancel()
+    {
+      m_eventId.cancel();
+    }
+
+    explicit
+    operator bool() const
+    {
+      return static_cast<bool>(m_eventId);
+    }
+
+  private:
+    EventId m_eventId;
+  };
+
+  /**
+   * @param scheduler Scheduler that runs the ticks.
+   * @param tick Granularity of the wheel.
+   */
+  explicit
+  TimerWheel(ndn::Scheduler& scheduler, ndn::time::nanoseconds tick = DEFAULT_TICK);
+
+  /**
+   * @brief Schedule @p callback to run after @p after .
+   */
+  EventId
+  schedule(ndn::time::nanoseconds after, ndn::scheduler::EventCallback callback);
+
+  /**
+   * @brief Return the number of pending events.
+   */
+  size_t
+  size() const
+  {
+    return *m_nPending;
+  }
+
+private:
+  /** @brief Return the number of ticks that have elapsed since the wheel was created. */
+  uint64_t
+  getElapsedTicks(const ndn::time::steady_clock::time_point& now) const;
+
+  /** @brief Put @p entry in the slot of the level that covers its distance from m_current. */
+  void
+  insert(std::shared_ptr<Entry> entry);
+
+  /** @brief Take all entries out of @p slot . */
+  static Slot
+  takeSlot(Slot& slot);
+
+  /** @brief Run the ticks that have elapsed, then schedule the next one if needed. */
+  void
+  onTick();
+
+  /** @brief Advance the wheel by one tick and run the events due in that tick. */
+  void
+  advance();
+
+  void
+  scheduleTick();
+
+public:
+  static constexpr ndn::time::nanoseconds DEFAULT_TICK = 1_s;
+
+private:
+  static constexpr size_t SLOT_BITS = 6;
+  static constexpr size_t N_SLOTS = 1 << SLOT_BITS;
+  static constexpr size_t N_LEVELS = 4;
+
+private:
+  ndn::Scheduler& m_scheduler;
+  const ndn::time::nanoseconds m_tick;
+  const ndn::time::steady_clock::time_point m_epoch;
+  /// Last tick that has been run
+  uint64_t m_current = 0;
+  std::shared_ptr<size_t> m_nPending = std::make_shared<size_t>(0);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::array<std::array<Slot, N_SLOTS>, N_LEVELS> m_levels;
+  /// Whether a tick is scheduled; false while no event is pending
+  bool m_isTicking = false;
+
+private:
+  ndn::scheduler::ScopedEventId m_tickEvent;
+};
+
+} // namespace nlsr::util
+
+#endif // NLSR_TIMER_WHEEL_HPP
@@ -132,6 +132,31 @@ BOOST_AUTO_TEST_CASE(InitializeFromContent)
   BOOST_CHECK_EQUAL(clsa1.wireEncode(), clsa2.wireEncode());
 }
 
+BOOST_AUTO_TEST_CASE(Embedding)
+{
+  auto testTimePoint = ndn::time::system_clock::now();
+  CoordinateLsa clsa1("router1", 12, testTimePoint, 2.5, {M_PI / 2, M_PI / 3});
+  const auto& unitVector = clsa1.getUnitVector();
+  BOOST_REQUIRE_EQUAL(unitVector.size(), 3);
+  BOOST_CHECK_SMALL(unitVector[0], 1e-9);
+  BOOST_CHECK_CLOSE(unitVector[1], 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(unitVector[2], std::sqrt(3) / 2, 1e-6);
+  BOOST_CHECK_CLOSE(clsa1.getCoshRadius(), std::cosh(2.5), 1e-6);
+  BOOST_CHECK_CLOSE(clsa1.getSinhRadius(), std::sinh(2.5), 1e-6);
+
+  // The embedding follows changes of the coordinates
+  clsa1.setTheta({M_PI});
+  BOOST_REQUIRE_EQUAL(clsa1.getUnitVector().size(), 2);
+  BOOST_CHECK_CLOSE(clsa1.getUnitVector()[0], -1.0, 1e-6);
+  CoordinateLsa clsa2(clsa1.wireEncode());
+  BOOST_CHECK_EQUAL(clsa2.getUnitVector().size(), 2);
+  BOOST_CHECK_CLOSE(clsa2.getUnitVector()[0], -1.0, 1e-6);
+
+  // The last angle must be within [0, 2π]
+  clsa1.setTheta({7.0});
+  BOOST_CHECK(clsa1.getUnitVector().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
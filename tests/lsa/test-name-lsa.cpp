@@ -26,6 +26,8 @@
 
 #include "tests/boost-test.hpp"
 
+#include <chrono>
+
 namespace nlsr::tests {
 
 BOOST_AUTO_TEST_SUITE(TestNameLsa)
@@ -233,6 +235,135 @@ BOOST_AUTO_TEST_CASE(Update)
   BOOST_CHECK(it != namesToAdd.end());
 }
 
+BOOST_AUTO_TEST_CASE(UpdateRemoveAndCost)
+{
+  auto testTimePoint = ndn::time::system_clock::now();
+  NamePrefixList knownNpl{"/name1", "/name2", "/name4"};
+  knownNpl.insert("/name5", "", 10);
+  NameLsa knownNameLsa("/router1", 5, testTimePoint, knownNpl);
+
+  NamePrefixList rcvdNpl{"/name2", "/name3"};
+  rcvdNpl.insert("/name5", "", 20);
+  auto rcvdLsa = std::make_shared<NameLsa>("/router1", 6, testTimePoint, rcvdNpl);
+
+  auto [updated, namesToAdd, namesToRemove] = knownNameLsa.update(rcvdLsa);
+  BOOST_CHECK_EQUAL(updated, true);
+  // A changed cost is reported as an addition
+  BOOST_CHECK(namesToAdd == (std::vector<PrefixInfo>{PrefixInfo("/name3", 0),
+                                                     PrefixInfo("/name5", 20)}));
+  BOOST_CHECK(namesToRemove == (std::vector<PrefixInfo>{PrefixInfo("/name1", 0),
+                                                        PrefixInfo("/name4", 0)}));
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl(), rcvdNpl);
+
+  std::tie(updated, namesToAdd, namesToRemove) = knownNameLsa.update(rcvdLsa);
+  BOOST_CHECK_EQUAL(updated, false);
+  BOOST_CHECK(namesToAdd.empty());
+  BOOST_CHECK(namesToRemove.empty());
+}
+
+BOOST_AUTO_TEST_CASE(UpdateLarge) // Benchmark
+{
+  const size_t nPrefixes = 20000;
+  const size_t nChanged = 200;
+  auto testTimePoint = ndn::time::system_clock::now();
+
+  NamePrefixList knownNpl;
+  NamePrefixList rcvdNpl;
+  for (size_t i = 0; i < nPrefixes; ++i) {
+    knownNpl.insert(ndn::Name("/prefix").appendNumber(i));
+    rcvdNpl.insert(ndn::Name("/prefix").appendNumber(i + nChanged));
+  }
+  NameLsa knownNameLsa("/router1", 5, testTimePoint, knownNpl);
+  auto rcvdLsa = std::make_shared<NameLsa>("/router1", 6, testTimePoint, rcvdNpl);
+
+  auto start = std::chrono::steady_clock::now();
+  auto [updated, namesToAdd, namesToRemove] = knownNameLsa.update(rcvdLsa);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  BOOST_TEST_MESSAGE("Updating a Name LSA of " << nPrefixes << " prefixes took " <<
+                     std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() <<
+                     " us");
+
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_CHECK_EQUAL(namesToAdd.size(), nChanged);
+  BOOST_CHECK_EQUAL(namesToRemove.size(), nChanged);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().size(), nPrefixes);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl(), rcvdNpl);
+}
+
+BOOST_AUTO_TEST_CASE(Delta)
+{
+  auto testTimePoint = ndn::time::system_clock::now();
+  NameLsa knownNameLsa("/router1", 5, testTimePoint, NamePrefixList{"/name1", "/name2"});
+
+  auto delta = std::make_shared<NameLsa>("/router1", 7, testTimePoint, 5,
+                                         NamePrefixList{"/name3"}, NamePrefixList{"/name1"});
+  BOOST_CHECK(delta->isDelta());
+  BOOST_CHECK_EQUAL(*delta->getBaseSeqNo(), 5);
+  BOOST_CHECK(!knownNameLsa.isDelta());
+
+  // A delta survives encoding
+  NameLsa decoded(delta->wireEncode());
+  BOOST_CHECK(decoded.isDelta());
+  BOOST_CHECK_EQUAL(decoded.getOriginRouter(), "/router1");
+  BOOST_CHECK_EQUAL(decoded.getSeqNo(), 7);
+  BOOST_CHECK_EQUAL(*decoded.getBaseSeqNo(), 5);
+  BOOST_CHECK_EQUAL(decoded.getNpl(), NamePrefixList{"/name3"});
+  BOOST_CHECK_EQUAL(decoded.getRemovedNpl(), NamePrefixList{"/name1"});
+  BOOST_CHECK_EQUAL(decoded.wireEncode(), delta->wireEncode());
+
+  // Only the added and removed prefixes are applied
+  auto [updated, namesToAdd, namesToRemove] = knownNameLsa.update(delta);
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_REQUIRE_EQUAL(namesToAdd.size(), 1);
+  BOOST_CHECK_EQUAL(namesToAdd.front().getName(), "/name3");
+  BOOST_REQUIRE_EQUAL(namesToRemove.size(), 1);
+  BOOST_CHECK_EQUAL(namesToRemove.front().getName(), "/name1");
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl(), (NamePrefixList{"/name2", "/name3"}));
+
+  // Applying it again changes nothing
+  std::tie(updated, namesToAdd, namesToRemove) = knownNameLsa.update(delta);
+  BOOST_CHECK_EQUAL(updated, false);
+}
+
+BOOST_AUTO_TEST_CASE(DeltaMetricsAndCost)
+{
+  auto testTimePoint = ndn::time::system_clock::now();
+  NamePrefixList npl;
+  npl.insert(PrefixInfo("/name1", 10));
+  npl.insert(PrefixInfo("/name2", 10));
+  NameLsa knownNameLsa("/router1", 5, testTimePoint, npl, 3.0, 0.5);
+
+  // Only the cost of a prefix changes
+  NamePrefixList changedCost;
+  changedCost.insert(PrefixInfo("/name1", 20));
+  auto delta = std::make_shared<NameLsa>("/router1", 6, testTimePoint, 5, changedCost,
+                                         NamePrefixList{}, 3.0, 0.5);
+  NameLsa decoded(delta->wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getNpl().getPrefixInfoForName("/name1").getCost(), 20);
+  BOOST_CHECK_EQUAL(decoded.getProcessingTime(), 3.0);
+  BOOST_CHECK_EQUAL(decoded.getLoadIndex(), 0.5);
+
+  auto [updated, namesToAdd, namesToRemove] = knownNameLsa.update(std::make_shared<NameLsa>(decoded));
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_REQUIRE_EQUAL(namesToAdd.size(), 1);
+  BOOST_CHECK_EQUAL(namesToAdd.front(), PrefixInfo("/name1", 20));
+  BOOST_CHECK(namesToRemove.empty());
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().getPrefixInfoForName("/name1").getCost(), 20);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().getPrefixInfoForName("/name2").getCost(), 10);
+
+  // Only the metrics change; the delta has no prefixes but still updates the LSA
+  delta = std::make_shared<NameLsa>("/router1", 7, testTimePoint, 6, NamePrefixList{},
+                                    NamePrefixList{}, 8.0, 0.25);
+  std::tie(updated, namesToAdd, namesToRemove) =
+    knownNameLsa.update(std::make_shared<NameLsa>(delta->wireEncode()));
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_CHECK(namesToAdd.empty());
+  BOOST_CHECK(namesToRemove.empty());
+  BOOST_CHECK_EQUAL(knownNameLsa.getProcessingTime(), 8.0);
+  BOOST_CHECK_EQUAL(knownNameLsa.getLoadIndex(), 0.25);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
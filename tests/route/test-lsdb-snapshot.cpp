@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/lsdb-snapshot.hpp"
+#include "adjacency-list.hpp"
+#include "lsdb.hpp"
+#include "name-prefix-list.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+namespace nlsr::tests {
+
+static const ndn::Name ROUTER_A_NAME = "/ndn/router/a";
+static const ndn::Name ROUTER_B_NAME = "/ndn/router/b";
+static const ndn::Name ROUTER_C_NAME = "/ndn/router/c";
+
+class LsdbSnapshotFixture : public IoKeyChainFixture
+{
+public:
+  ndn::DummyClientFace face{m_io, m_keyChain, {true, true}};
+  ConfParameter conf{face, m_keyChain};
+  DummyConfFileProcessor confProcessor{conf};
+  Lsdb lsdb{face, m_keyChain, conf};
+  time::system_clock::time_point expiration = time::system_clock::now() + 3600_s;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLsdbSnapshot, LsdbSnapshotFixture)
+
+BOOST_AUTO_TEST_CASE(FindLsa)
+{
+  AdjacencyList adjacencies;
+  adjacencies.insert(Adjacent(ROUTER_B_NAME));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_A_NAME, 1, expiration, adjacencies));
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_A_NAME, 1, expiration,
+                                            NamePrefixList{"/prefix/a"}, 2.5, 0.75));
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(ROUTER_A_NAME, 1, expiration, 16.23,
+                                                  std::vector<double>{1.45}));
+
+  LsdbSnapshot snapshot(lsdb, conf.getAdjacencyList());
+
+  auto adjLsa = snapshot.findLsa<AdjLsa>(ROUTER_A_NAME);
+  BOOST_REQUIRE(adjLsa != nullptr);
+  BOOST_CHECK_EQUAL(adjLsa->getAdl().size(), 1);
+  // Name LSAs are copied without their prefixes, which the calculators do not read
+  auto nameLsa = snapshot.findLsa<NameLsa>(ROUTER_A_NAME);
+  BOOST_REQUIRE(nameLsa != nullptr);
+  BOOST_CHECK_EQUAL(nameLsa->getProcessingTime(), 2.5);
+  BOOST_CHECK_EQUAL(nameLsa->getLoadIndex(), 0.75);
+  BOOST_CHECK_EQUAL(nameLsa->getNpl().size(), 0);
+  BOOST_REQUIRE(snapshot.findLsa<CoordinateLsa>(ROUTER_A_NAME) != nullptr);
+  BOOST_CHECK_EQUAL(snapshot.findLsa<CoordinateLsa>(ROUTER_A_NAME)->getRadius(), 16.23);
+  BOOST_CHECK(snapshot.findLsa<AdjLsa>(ROUTER_B_NAME) == nullptr);
+
+  // Same LSAs, in the same order, as the LSDB
+  auto lsdbRange = lsdb.getLsdbIterator<AdjLsa>();
+  auto snapshotRange = snapshot.getLsdbIterator<AdjLsa>();
+  BOOST_CHECK(std::equal(lsdbRange.first, lsdbRange.second,
+                         snapshotRange.first, snapshotRange.second,
+                         [] (const auto& lhs, const auto& rhs) {
+                           return lhs->getOriginRouter() == rhs->getOriginRouter();
+                         }));
+}
+
+BOOST_AUTO_TEST_CASE(Immutable)
+{
+  AdjacencyList adjacencies;
+  adjacencies.insert(Adjacent(ROUTER_B_NAME));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_A_NAME, 1, expiration, adjacencies));
+  conf.getAdjacencyList().insert(Adjacent(ROUTER_B_NAME));
+
+  LsdbSnapshot snapshot(lsdb, conf.getAdjacencyList());
+
+  // The LSDB updates LSAs in place, which must not reach the snapshot
+  adjacencies.insert(Adjacent(ROUTER_C_NAME));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_A_NAME, 2, expiration, adjacencies));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_B_NAME, 1, expiration, adjacencies));
+  conf.getAdjacencyList().insert(Adjacent(ROUTER_C_NAME));
+
+  BOOST_CHECK_EQUAL(lsdb.findLsa<AdjLsa>(ROUTER_A_NAME)->getAdl().size(), 2);
+  auto adjLsa = snapshot.findLsa<AdjLsa>(ROUTER_A_NAME);
+  BOOST_REQUIRE(adjLsa != nullptr);
+  BOOST_CHECK_EQUAL(adjLsa->getSeqNo(), 1);
+  BOOST_CHECK_EQUAL(adjLsa->getAdl().size(), 1);
+  BOOST_CHECK(snapshot.findLsa<AdjLsa>(ROUTER_B_NAME) == nullptr);
+  BOOST_CHECK_EQUAL(snapshot.getAdjacencyList().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(NotDetached)
+{
+  AdjacencyList adjacencies;
+  adjacencies.insert(Adjacent(ROUTER_B_NAME));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_A_NAME, 1, expiration, adjacencies));
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_A_NAME, 1, expiration,
+                                            NamePrefixList{"/prefix/a"}));
+
+  LsdbSnapshot snapshot(lsdb, conf.getAdjacencyList(), false);
+
+  // Nothing is copied; the snapshot reads the LSAs of the LSDB
+  BOOST_CHECK(snapshot.findLsa<AdjLsa>(ROUTER_A_NAME) == lsdb.findLsa<AdjLsa>(ROUTER_A_NAME));
+  BOOST_CHECK(snapshot.findLsa<NameLsa>(ROUTER_A_NAME) == lsdb.findLsa<NameLsa>(ROUTER_A_NAME));
+  BOOST_CHECK(*snapshot.getLsdbIterator<AdjLsa>().first == lsdb.findLsa<AdjLsa>(ROUTER_A_NAME));
+  BOOST_CHECK_EQUAL(&snapshot.getAdjacencyList(), &conf.getAdjacencyList());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLsdbSnapshot
+
+} // namespace nlsr::tests
@@ -56,6 +56,27 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(map1.getRouterNameByMappingNo(mn3).has_value(), false);
 }
 
+BOOST_AUTO_TEST_CASE(HasSameRouters)
+{
+  NameMap map1;
+  map1.addEntry("/r1");
+  map1.addEntry("/r2");
+
+  NameMap map2;
+  map2.addEntry("/r2");
+  map2.addEntry("/r1");
+  BOOST_CHECK(map1.hasSameRouters(map2));
+  BOOST_CHECK(map2.hasSameRouters(map1));
+
+  map2.addEntry("/r3");
+  BOOST_CHECK(!map1.hasSameRouters(map2));
+
+  NameMap map3;
+  map3.addEntry("/r1");
+  map3.addEntry("/r3");
+  BOOST_CHECK(!map1.hasSameRouters(map3));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -36,7 +36,7 @@ public:
   NamePrefixTableFixture()
     : lsdb(face, m_keyChain, conf)
     , fib(face, m_scheduler, conf.getAdjacencyList(), conf, m_keyChain)
-    , rt(m_scheduler, lsdb, conf)
+    , rt(m_scheduler, m_io, lsdb, conf)
     , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified)
   {
   }
@@ -260,7 +260,7 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
   rt.addNextHop(destination, hop1);
   rt.addNextHop(destination, hop2);
 
-  npt.updateWithNewRoute(rt.m_rTable);
+  npt.updateWithNewRoute(diffRoutingTables({}, rt.m_rTable));
 
   // At this point the NamePrefixTableEntry should have two NextHops.
   auto nameIterator = std::find_if(npt.begin(), npt.end(),
@@ -275,8 +275,9 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
   BOOST_CHECK_EQUAL(nextHops.size(), 2);
 
   // Add the other NextHop
+  auto oldTable = rt.m_rTable;
   rt.addNextHop(destination, hop3);
-  npt.updateWithNewRoute(rt.m_rTable);
+  npt.updateWithNewRoute(diffRoutingTables(oldTable, rt.m_rTable));
 
   // At this point the NamePrefixTableEntry should have three NextHops.
   nameIterator = std::find_if(npt.begin(), npt.end(),
@@ -288,6 +289,11 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
   nextHops = (iterator->second)->getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 3);
+
+  // The destination is no longer reachable
+  npt.updateWithNewRoute(diffRoutingTables(rt.m_rTable, {}));
+  BOOST_CHECK_EQUAL(npt.m_rtpool.at(destination)->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL((*nameIterator)->getNexthopList().size(), 0);
 }
 
 BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
@@ -30,6 +30,10 @@
 #include "tests/io-key-chain-fixture.hpp"
 #include "tests/test-common.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 namespace nlsr::tests {
 
 constexpr time::system_clock::time_point MAX_TIME = time::system_clock::time_point::max();
@@ -105,7 +109,8 @@ public:
 
   void runTest(const double& expectedCost)
   {
-    calculateHyperbolicRoutingPath(map, routingTable, lsdb, adjacencies, ROUTER_A_NAME, false);
+    LsdbSnapshot snapshot(lsdb, adjacencies);
+    calculateHyperbolicRoutingPath(map, routingTable, snapshot, ROUTER_A_NAME, false);
 
     RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
 
@@ -156,6 +161,65 @@ public:
   Lsdb& lsdb;
 };
 
+/**
+ * @brief Hyperbolic calculation as it was done before embeddings were cached: the distance of
+ *        every pair is computed from the angles of the two Coordinate LSAs, looked up and
+ *        copied for each pair.
+ */
+static void
+calculateHyperbolicPerPair(const NameMap& map, RoutingTableStatus& rt, const LsdbSnapshot& lsdb,
+                           const ndn::Name& thisRouterName)
+{
+  auto thisRouter = map.getMappingNoByRouterName(thisRouterName);
+  for (const auto& adj : lsdb.getAdjacencyList().getAdjList()) {
+    auto src = map.getMappingNoByRouterName(adj.getName());
+    if (adj.getStatus() == Adjacent::STATUS_INACTIVE || !src || !thisRouter) {
+      continue;
+    }
+    NextHop direct(adj.getFaceUri(), 0);
+    direct.setHyperbolic(true);
+    rt.addNextHop(adj.getName(), direct);
+
+    for (int dest = 0; dest < static_cast<int>(map.size()); ++dest) {
+      auto destRouterName = map.getRouterNameByMappingNo(dest);
+      if (dest == *thisRouter || dest == *src || !destRouterName) {
+        continue;
+      }
+      auto srcLsa = lsdb.findLsa<CoordinateLsa>(adj.getName());
+      auto destLsa = lsdb.findLsa<CoordinateLsa>(*destRouterName);
+      std::vector<double> thetaI = srcLsa->getTheta();
+      std::vector<double> thetaJ = destLsa->getTheta();
+
+      // Inner product of the Cartesian coordinates on the unit sphere
+      size_t n = thetaI.size();
+      double xni = std::sin(thetaI[n - 1]);
+      double xnj = std::sin(thetaJ[n - 1]);
+      for (size_t k = 0; k < n - 1; ++k) {
+        xni *= std::sin(thetaI[k]);
+        xnj *= std::sin(thetaJ[k]);
+      }
+      double innerProduct = std::cos(thetaI[0]) * std::cos(thetaJ[0]) + xni * xnj;
+      for (size_t m = 1; m < n; ++m) {
+        double xmi = std::cos(thetaI[m]);
+        double xmj = std::cos(thetaJ[m]);
+        for (size_t l = 0; l < m; ++l) {
+          xmi *= std::sin(thetaI[l]);
+          xmj *= std::sin(thetaJ[l]);
+        }
+        innerProduct += xmi * xmj;
+      }
+
+      double rI = srcLsa->getRadius();
+      double rJ = destLsa->getRadius();
+      double distance = std::acosh(std::cosh(rI) * std::cosh(rJ) -
+                                   std::sinh(rI) * std::sinh(rJ) * std::cos(std::acos(innerProduct)));
+      NextHop hop(adj.getFaceUri(), distance);
+      hop.setHyperbolic(true);
+      rt.addNextHop(*destRouterName, hop);
+    }
+  }
+}
+
 BOOST_FIXTURE_TEST_SUITE(TestRoutingCalculatorHyperbolic, HyperbolicCalculatorFixture)
 
 BOOST_AUTO_TEST_CASE(Basic)
@@ -178,6 +242,119 @@ BOOST_AUTO_TEST_CASE(BasicMultipleAngles)
   runTest(30.655296361);
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalUpdate)
+{
+  setUpTopology({2.97}, {3.0}, {2.99});
+
+  HyperbolicCache cache;
+  RoutingTableStatus rt1;
+  calculateHyperbolicRoutingPath(map, rt1, LsdbSnapshot(lsdb, adjacencies), ROUTER_A_NAME, false,
+                                 &cache);
+  auto b = cache.map.getMappingNoByRouterName(ROUTER_B_NAME);
+  BOOST_REQUIRE(b.has_value());
+  BOOST_CHECK_EQUAL(cache.distances.at(*b).size(), 3);
+
+  // Router C moves
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(ROUTER_C_NAME, 2, MAX_TIME, 14.11,
+                                                  std::vector<double>{2.5}));
+  cache.changedCoordinateLsas.insert(ROUTER_C_NAME);
+
+  auto lsaRange = lsdb.getLsdbIterator<CoordinateLsa>();
+  auto map2 = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+  RoutingTableStatus incremental;
+  calculateHyperbolicRoutingPath(map2, incremental, LsdbSnapshot(lsdb, adjacencies), ROUTER_A_NAME,
+                                 false, &cache);
+  BOOST_CHECK(cache.changedCoordinateLsas.empty());
+
+  auto map3 = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+  RoutingTableStatus full;
+  calculateHyperbolicRoutingPath(map3, full, LsdbSnapshot(lsdb, adjacencies), ROUTER_A_NAME,
+                                 false);
+
+  BOOST_CHECK_NE(incremental.findRoutingTableEntry(ROUTER_B_NAME)->getNexthopList(),
+                 rt1.findRoutingTableEntry(ROUTER_B_NAME)->getNexthopList());
+  for (const auto& rte : full.getRoutingTableEntry()) {
+    auto entry = incremental.findRoutingTableEntry(rte.getDestination());
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK_EQUAL(entry->getNexthopList(), rte.getNexthopList());
+  }
+  BOOST_CHECK_EQUAL(incremental.getRoutingTableEntry().size(), full.getRoutingTableEntry().size());
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLarge) // Benchmark
+{
+  const size_t nRouters = 10000;
+  const size_t nNeighbors = 8;
+  auto routerName = [] (size_t i) { return ndn::Name("/ndn/router").appendNumber(i); };
+
+  // Router 0 is this router, and routers 1 to nNeighbors are its neighbors
+  for (size_t i = 0; i < nRouters; ++i) {
+    double radius = 10.0 + static_cast<double>(i % 100) / 10.0;
+    std::vector<double> angles{0.1 + 3.0 * static_cast<double>(i) / nRouters,
+                               6.0 * static_cast<double>(i) / nRouters};
+    lsdb.installLsa(std::make_shared<CoordinateLsa>(routerName(i), 1, MAX_TIME, radius, angles));
+  }
+  for (size_t i = 1; i <= nNeighbors; ++i) {
+    ndn::FaceUri faceUri("udp4://10.0.1." + std::to_string(i) + ":6363");
+    adjacencies.insert(Adjacent(routerName(i), faceUri, 0, Adjacent::STATUS_ACTIVE, 0, 0));
+  }
+  auto lsaRange = lsdb.getLsdbIterator<CoordinateLsa>();
+  LsdbSnapshot snapshot(lsdb, adjacencies);
+
+  auto measure = [] (const auto& calculate) {
+    auto start = std::chrono::steady_clock::now();
+    calculate();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  };
+
+  RoutingTableStatus perPair;
+  auto perPairMap = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+  auto perPairTime = measure([&] {
+    calculateHyperbolicPerPair(perPairMap, perPair, snapshot, routerName(0));
+  });
+
+  HyperbolicCache cache;
+  RoutingTableStatus full;
+  auto fullMap = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+  auto fullTime = measure([&] {
+    calculateHyperbolicRoutingPath(fullMap, full, snapshot, routerName(0), false, &cache);
+  });
+
+  // A router that is not a neighbor moves
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(routerName(nRouters - 1), 2, MAX_TIME, 12.0,
+                                                  std::vector<double>{1.0, 2.0}));
+  cache.changedCoordinateLsas.insert(routerName(nRouters - 1));
+  RoutingTableStatus incremental;
+  auto incrementalMap = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+  auto incrementalTime = measure([&] {
+    calculateHyperbolicRoutingPath(incrementalMap, incremental, LsdbSnapshot(lsdb, adjacencies),
+                                   routerName(0), false, &cache);
+  });
+
+  BOOST_TEST_MESSAGE("Hyperbolic calculation over " << nRouters << " routers and " << nNeighbors <<
+                     " neighbors took " << perPairTime << " us per pair, " << fullTime <<
+                     " us in bulk and " << incrementalTime << " us after one router moved");
+  BOOST_WARN_GE(perPairTime, 10 * fullTime);
+
+  // Both calculations find the same next hops
+  BOOST_REQUIRE_EQUAL(full.getRoutingTableEntry().size(), perPair.getRoutingTableEntry().size());
+  for (const auto& rte : perPair.getRoutingTableEntry()) {
+    auto entry = full.findRoutingTableEntry(rte.getDestination());
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_REQUIRE_EQUAL(entry->getNexthopList().size(), rte.getNexthopList().size());
+    for (const auto& nextHop : rte.getNexthopList()) {
+      auto it = std::find_if(entry->getNexthopList().begin(), entry->getNexthopList().end(),
+                             [&] (const NextHop& nh) {
+                               return nh.getConnectingFaceUri() == nextHop.getConnectingFaceUri();
+                             });
+      BOOST_REQUIRE(it != entry->getNexthopList().end());
+      BOOST_CHECK_CLOSE(it->getRouteCost(), nextHop.getRouteCost(), 1e-6);
+    }
+  }
+  BOOST_CHECK_EQUAL(incremental.getRoutingTableEntry().size(), nRouters - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
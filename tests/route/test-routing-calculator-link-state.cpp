@@ -24,6 +24,7 @@
 #include "adjacency-list.hpp"
 #include "adjacent.hpp"
 #include "lsdb.hpp"
+#include "lsa/name-lsa.hpp"
 #include "nlsr.hpp"
 #include "route/name-map.hpp"
 #include "route/routing-table.hpp"
@@ -91,7 +92,7 @@ public:
    * @brief Insert Adjacency LSA of router B into LSDB.
    */
   void
-  setupRouterB(double costBC = LINK_BC_COST, double costBA = LINK_AB_COST)
+  setupRouterB(double costBC = LINK_BC_COST, double costBA = LINK_AB_COST, uint64_t seqNo = 1)
   {
     AdjacencyList adjList;
     if (!std::isnan(costBC)) {
@@ -101,14 +102,14 @@ public:
       adjList.insert(Adjacent(ROUTER_A_NAME, ROUTER_A_FACE, costBA, Adjacent::STATUS_ACTIVE, 0, 0));
     }
 
-    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_B_NAME, 1, MAX_TIME, adjList));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_B_NAME, seqNo, MAX_TIME, adjList));
   }
 
   /**
    * @brief Insert Adjacency LSA of router C into LSDB.
    */
   void
-  setupRouterC(double costCA = LINK_AC_COST, double costCB = LINK_BC_COST)
+  setupRouterC(double costCA = LINK_AC_COST, double costCB = LINK_BC_COST, uint64_t seqNo = 1)
   {
     AdjacencyList adjList;
     if (!std::isnan(costCA)) {
@@ -118,18 +119,19 @@ public:
       adjList.insert(Adjacent(ROUTER_B_NAME, ROUTER_B_FACE, costCB, Adjacent::STATUS_ACTIVE, 0, 0));
     }
 
-    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_C_NAME, 1, MAX_TIME, adjList));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_C_NAME, seqNo, MAX_TIME, adjList));
   }
 
   /**
    * @brief Run link-state routing calculator.
    */
   void
-  calculatePath()
+  calculatePath(boost::asio::thread_pool* workerPool = nullptr, LinkStateCache* cache = nullptr)
   {
     auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
     NameMap map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
-    calculateLinkStateRoutingPath(map, routingTable, conf, lsdb);
+    LsdbSnapshot snapshot(lsdb, conf.getAdjacencyList());
+    calculateLinkStateRoutingPath(map, routingTable, conf, snapshot, workerPool, cache);
   }
 
   /**
@@ -292,6 +294,97 @@ BOOST_AUTO_TEST_CASE(OnePath)
   });
 }
 
+BOOST_AUTO_TEST_CASE(WorkerThreads)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+  calculatePath();
+  ndn::Block expected = routingTable.wireEncode();
+
+  routingTable.m_rTable.clear();
+  routingTable.m_wire.reset();
+
+  // Each neighbor is handled by a different worker; the merged result must not change
+  conf.setRoutingWorkerThreads(2);
+  boost::asio::thread_pool workerPool(2);
+  calculatePath(&workerPool);
+
+  BOOST_CHECK_EQUAL(routingTable.wireEncode(), expected);
+}
+
+BOOST_AUTO_TEST_CASE(Incremental)
+{
+  conf.setIncrementalSpfState(INCREMENTAL_SPF_VALIDATE);
+  LinkStateCache cache;
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+  calculatePath(nullptr, &cache);
+  BOOST_CHECK_EQUAL(cache.trees.size(), 2);
+
+  // Link B-C goes down
+  setupRouterB(NAN, LINK_AB_COST, 2);
+  setupRouterC(LINK_AC_COST, NAN, 2);
+  routingTable.m_rTable.clear();
+  routingTable.m_wire.reset();
+  calculatePath(nullptr, &cache);
+  ndn::Block incremental = routingTable.wireEncode();
+
+  routingTable.m_rTable.clear();
+  routingTable.m_wire.reset();
+  calculatePath();
+  BOOST_CHECK_EQUAL(routingTable.wireEncode(), incremental);
+
+  // Without link B-C, C is only reachable through C and B only through B
+  auto mapB = cache.map.getMappingNoByRouterName(ROUTER_B_NAME);
+  auto mapC = cache.map.getMappingNoByRouterName(ROUTER_C_NAME);
+  BOOST_REQUIRE(mapB && mapC);
+  for (size_t k = 0; k < cache.trees.size(); ++k) {
+    int other = cache.firstHops[k] == *mapB ? *mapC : *mapB;
+    BOOST_CHECK_EQUAL(cache.trees[k].distance[other], INF_DISTANCE);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NodeCost)
+{
+  conf.setLoadWeight(0.5);
+  conf.setProcessingTimeWeight(0.25);
+  LinkStateCache cache;
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_B_NAME, 1, MAX_TIME, NamePrefixList{}, 8, 2));
+  calculatePath(nullptr, &cache);
+
+  auto mapB = cache.map.getMappingNoByRouterName(ROUTER_B_NAME);
+  auto mapC = cache.map.getMappingNoByRouterName(ROUTER_C_NAME);
+  BOOST_REQUIRE(mapB && mapC);
+  BOOST_CHECK_EQUAL(cache.nodeCost.at(*mapB), 2 * 0.5 + 8 * 0.25);
+  BOOST_CHECK_EQUAL(cache.nodeCost.at(*mapC), 0);
+
+  // The service cost is added to the cost of the next hops toward B
+  const RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
+  BOOST_REQUIRE(entryB != nullptr);
+  for (const auto& nextHop : entryB->getNexthopList()) {
+    if (nextHop.getConnectingFaceUri() == ROUTER_B_FACE) {
+      BOOST_CHECK_CLOSE(nextHop.getRouteCost(), LINK_AB_COST + 2 * 0.5 + 8 / 1000.0 * 0.25, 1e-9);
+    }
+  }
+
+  // Costs are only recomputed for routers whose Name LSA is reported as changed
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_C_NAME, 1, MAX_TIME, NamePrefixList{}, 4, 0));
+  cache.changedNameLsas.clear();
+  calculatePath(nullptr, &cache);
+  BOOST_CHECK_EQUAL(cache.nodeCost.at(*mapC), 0);
+
+  cache.changedNameLsas.insert(ROUTER_C_NAME);
+  calculatePath(nullptr, &cache);
+  BOOST_CHECK_EQUAL(cache.nodeCost.at(*mapB), 2 * 0.5 + 8 * 0.25);
+  BOOST_CHECK_EQUAL(cache.nodeCost.at(*mapC), 4 * 0.25);
+  BOOST_CHECK(cache.changedNameLsas.empty());
+}
+
 BOOST_AUTO_TEST_CASE(SourceRouterAbsent)
 {
   // RouterA does not exist in the LSDB.
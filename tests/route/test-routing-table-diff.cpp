@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/routing-table-diff.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+static const ndn::FaceUri FACE_A("udp4://10.0.0.1:6363");
+static const ndn::FaceUri FACE_B("udp4://10.0.0.2:6363");
+
+static RoutingTableEntry
+makeEntry(const ndn::Name& dest, const ndn::FaceUri& faceUri, double cost)
+{
+  RoutingTableEntry rte(dest);
+  rte.getNexthopList().addNextHop(NextHop(faceUri, cost));
+  return rte;
+}
+
+BOOST_AUTO_TEST_SUITE(TestRoutingTableDiff)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  RoutingTableEntryList oldTable{
+    makeEntry("/router/kept", FACE_A, 10),
+    makeEntry("/router/removed", FACE_A, 10),
+    makeEntry("/router/changed", FACE_A, 10),
+  };
+  RoutingTableEntryList newTable{
+    makeEntry("/router/changed", FACE_B, 20),
+    makeEntry("/router/added", FACE_B, 10),
+    makeEntry("/router/kept", FACE_A, 10),
+  };
+
+  auto diff = diffRoutingTables(oldTable, newTable);
+  BOOST_CHECK_EQUAL(diff.size(), 3);
+
+  BOOST_REQUIRE_EQUAL(diff.added.size(), 1);
+  BOOST_CHECK_EQUAL(diff.added[0].destination, "/router/added");
+  BOOST_CHECK_EQUAL(diff.added[0].oldNexthops.size(), 0);
+  BOOST_CHECK_EQUAL(diff.added[0].newNexthops, std::next(newTable.begin())->getNexthopList());
+
+  BOOST_REQUIRE_EQUAL(diff.removed.size(), 1);
+  BOOST_CHECK_EQUAL(diff.removed[0].destination, "/router/removed");
+  BOOST_CHECK_EQUAL(diff.removed[0].oldNexthops.size(), 1);
+  BOOST_CHECK_EQUAL(diff.removed[0].newNexthops.size(), 0);
+
+  BOOST_REQUIRE_EQUAL(diff.changed.size(), 1);
+  BOOST_CHECK_EQUAL(diff.changed[0].destination, "/router/changed");
+  BOOST_CHECK_EQUAL(diff.changed[0].oldNexthops.begin()->getConnectingFaceUri(), FACE_A);
+  BOOST_CHECK_EQUAL(diff.changed[0].newNexthops.begin()->getConnectingFaceUri(), FACE_B);
+}
+
+BOOST_AUTO_TEST_CASE(Unchanged)
+{
+  RoutingTableEntryList table{
+    makeEntry("/router/a", FACE_A, 10),
+    makeEntry("/router/b", FACE_B, 10),
+  };
+  RoutingTableEntryList reordered{
+    makeEntry("/router/b", FACE_B, 10),
+    makeEntry("/router/a", FACE_A, 10),
+  };
+
+  BOOST_CHECK(diffRoutingTables(table, reordered).empty());
+  BOOST_CHECK(diffRoutingTables({}, {}).empty());
+
+  // Backup next hops are not installed in the FIB
+  reordered.find("/router/a")->setBackupNextHop(NextHop(FACE_A, 30));
+  BOOST_CHECK(diffRoutingTables(table, reordered).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRoutingTableDiff
+
+} // namespace nlsr::tests
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/routing-table-entry-list.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestRoutingTableEntryList)
+
+BOOST_AUTO_TEST_CASE(FindOrInsert)
+{
+  RoutingTableEntryList entries;
+  BOOST_CHECK(entries.empty());
+  BOOST_CHECK(entries.find("/router/a") == nullptr);
+
+  NextHop hop1(ndn::FaceUri("udp4://10.0.0.1:6363"), 10);
+  NextHop hop2(ndn::FaceUri("udp4://10.0.0.2:6363"), 20);
+  entries.findOrInsert("/router/b").getNexthopList().addNextHop(hop1);
+  entries.findOrInsert("/router/a").getNexthopList().addNextHop(hop1);
+  entries.findOrInsert("/router/b").getNexthopList().addNextHop(hop2);
+  BOOST_CHECK_EQUAL(entries.size(), 2);
+
+  BOOST_REQUIRE(entries.find("/router/b") != nullptr);
+  BOOST_CHECK_EQUAL(entries.find("/router/b")->getNexthopList().size(), 2);
+  BOOST_REQUIRE(entries.find("/router/a") != nullptr);
+  BOOST_CHECK_EQUAL(entries.find("/router/a")->getNexthopList().size(), 1);
+
+  // Entries are iterated in insertion order
+  std::vector<ndn::Name> destinations;
+  for (const auto& rte : entries) {
+    destinations.push_back(rte.getDestination());
+  }
+  std::vector<ndn::Name> expected{"/router/b", "/router/a"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(destinations.begin(), destinations.end(),
+                                expected.begin(), expected.end());
+
+  entries.clear();
+  BOOST_CHECK(entries.empty());
+  BOOST_CHECK(entries.find("/router/a") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(PushBack)
+{
+  RoutingTableEntryList entries;
+  BOOST_CHECK(entries.push_back(RoutingTableEntry("/router/a")));
+  BOOST_CHECK(entries.push_back(RoutingTableEntry("/router/b")));
+  BOOST_CHECK(!entries.push_back(RoutingTableEntry("/router/a")));
+  BOOST_CHECK_EQUAL(entries.size(), 2);
+  BOOST_CHECK_EQUAL(entries.begin()->getDestination(), "/router/a");
+  BOOST_CHECK_EQUAL(entries.rbegin()->getDestination(), "/router/b");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRoutingTableEntryList
+
+} // namespace nlsr::tests
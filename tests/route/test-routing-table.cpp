@@ -39,7 +39,54 @@ public:
   DummyConfFileProcessor confProcessor{conf};
 
   Lsdb lsdb{face, m_keyChain, conf};
-  RoutingTable rt{m_scheduler, lsdb, conf};
+  RoutingTable rt{m_scheduler, m_io, lsdb, conf};
+};
+
+static const ndn::Name ROUTER2_NAME("/ndn/router2");
+static const ndn::FaceUri ROUTER2_FACE("udp4://10.0.0.2:6363");
+
+/**
+ * @brief Routing table that calculates on a background thread, with one neighbor /ndn/router2.
+ */
+class AsyncRoutingTableFixture : public RoutingTableFixture
+{
+public:
+  AsyncRoutingTableFixture()
+  {
+    conf.setAsyncCalculationEnabled(true);
+    asyncRt = std::make_unique<RoutingTable>(scheduler, m_io, lsdb, conf);
+
+    conf.getAdjacencyList().insert(Adjacent(ROUTER2_NAME, ROUTER2_FACE, 10,
+                                            Adjacent::STATUS_ACTIVE, 0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(conf.getRouterPrefix(), 1, expiration,
+                                             conf.getAdjacencyList()));
+    installRouter2AdjLsa(1, 10);
+    lsdb.installLsa(std::make_shared<NameLsa>(ROUTER2_NAME, 1, expiration, NamePrefixList()));
+  }
+
+  void
+  installRouter2AdjLsa(uint64_t seqNo, double linkCost)
+  {
+    AdjacencyList adjacencies;
+    adjacencies.insert(Adjacent(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1:6363"),
+                                linkCost, Adjacent::STATUS_ACTIVE, 0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER2_NAME, seqNo, expiration, adjacencies));
+  }
+
+  /**
+   * @brief Wait for the background calculation, then handle its result on the main thread.
+   */
+  void
+  finishCalculation()
+  {
+    asyncRt->m_calculationThread->join();
+    advanceClocks(1_ms);
+  }
+
+public:
+  time::system_clock::time_point expiration = time::system_clock::now() + 3600_s;
+  ndn::Scheduler scheduler{m_io};
+  std::unique_ptr<RoutingTable> asyncRt;
 };
 
 BOOST_AUTO_TEST_SUITE(TestRoutingTable)
@@ -53,6 +100,230 @@ BOOST_FIXTURE_TEST_CASE(AddNextHop, RoutingTableFixture)
   BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(DEST_ROUTER)->getDestination(), DEST_ROUTER);
 }
 
+BOOST_FIXTURE_TEST_CASE(SwitchToBackupNextHops, RoutingTableFixture)
+{
+  const ndn::FaceUri FACE_A("udp4://10.0.0.1:6363");
+  const ndn::FaceUri FACE_B("udp4://10.0.0.2:6363");
+  NextHop nhA(FACE_A, 10);
+  NextHop nhB(FACE_B, 20);
+  rt.addNextHop("/dest1", nhA);
+  rt.setBackupNextHop("/dest1", nhB);
+  rt.addNextHop("/dest2", nhB);
+
+  int nNotifications = 0;
+  rt.afterRoutingChange.connect([&] (const auto&) { ++nNotifications; });
+
+  // Nothing happens unless fast reroute is enabled
+  rt.switchToBackupNextHops(FACE_A);
+  BOOST_CHECK_EQUAL(nNotifications, 0);
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry("/dest1")->getNexthopList().size(), 1);
+
+  conf.setFastRerouteEnabled(true);
+  rt.switchToBackupNextHops(FACE_A);
+  BOOST_CHECK_EQUAL(nNotifications, 1);
+  const auto& nextHops1 = rt.findRoutingTableEntry("/dest1")->getNexthopList();
+  BOOST_REQUIRE_EQUAL(nextHops1.size(), 1);
+  BOOST_CHECK_EQUAL(nextHops1.begin()->getConnectingFaceUri(), FACE_B);
+  BOOST_CHECK(nextHops1.begin()->isBackup());
+
+  // dest2 has no backup, so it is left without next hops
+  rt.switchToBackupNextHops(FACE_B);
+  BOOST_CHECK_EQUAL(nNotifications, 2);
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry("/dest1")->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry("/dest2")->getNexthopList().size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(BackupNextHopPreference, RoutingTableFixture)
+{
+  const ndn::FaceUri FACE_A("udp4://10.0.0.1:6363");
+  const ndn::FaceUri FACE_B("udp4://10.0.0.2:6363");
+  const ndn::FaceUri FACE_C("udp4://10.0.0.3:6363");
+  NextHop nhA(FACE_A, 10);
+  NextHop nhC(FACE_C, 30);
+  rt.addNextHop("/dest1", nhA);
+  rt.addNextHop("/dest1", nhC);
+  rt.setBackupNextHop("/dest1", NextHop(FACE_B, 20));
+  conf.setFastRerouteEnabled(true);
+
+  // The backup is cheaper than the remaining primary next hop, but must not be preferred to it
+  rt.switchToBackupNextHops(FACE_A);
+  const auto& nextHops = rt.findRoutingTableEntry("/dest1")->getNexthopList();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_EQUAL(nextHops.begin()->getConnectingFaceUri(), FACE_C);
+  BOOST_CHECK(!nextHops.begin()->isBackup());
+  const auto& backup = *std::next(nextHops.begin());
+  BOOST_CHECK_EQUAL(backup.getConnectingFaceUri(), FACE_B);
+  BOOST_CHECK(backup.isBackup());
+  BOOST_CHECK_GT(backup.getRouteCost(), nhA.getRouteCost());
+  BOOST_CHECK_GT(backup.getRouteCost(), nhC.getRouteCost());
+}
+
+BOOST_FIXTURE_TEST_CASE(ThrottleCalculation, RoutingTableFixture)
+{
+  int nSaved = 0;
+  rt.rtIncrementSignal.connect([&] (Statistics::PacketType type) {
+    if (type == Statistics::PacketType::ROUTING_CALC_SAVED) {
+      ++nSaved;
+    }
+  });
+
+  // The first change after a quiet period is calculated after the initial wait
+  rt.scheduleRoutingTableCalculation();
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(10_ms, 5);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+
+  // Changes that follow wait for the increment, and are merged while a calculation is pending
+  rt.scheduleRoutingTableCalculation();
+  rt.scheduleRoutingTableCalculation();
+  rt.scheduleRoutingTableCalculation();
+  BOOST_CHECK_EQUAL(nSaved, 2);
+  advanceClocks(10_ms, 19);
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(10_ms);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+
+  // The wait doubles while changes keep coming, up to the routing calculation interval
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(10_ms, 39);
+  BOOST_CHECK(rt.m_isRouteCalculationScheduled);
+  advanceClocks(10_ms);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+  BOOST_CHECK_EQUAL(rt.m_routingCalcHoldTime, 800_ms);
+
+  for (int i = 0; i < 10; ++i) {
+    rt.scheduleRoutingTableCalculation();
+    while (rt.m_isRouteCalculationScheduled) {
+      advanceClocks(100_ms);
+    }
+  }
+  BOOST_CHECK_EQUAL(rt.m_routingCalcHoldTime, rt.m_routingCalcInterval);
+
+  // The backoff is reset after a quiet period
+  advanceClocks(1_s, 31);
+  rt.scheduleRoutingTableCalculation();
+  BOOST_CHECK_EQUAL(rt.m_routingCalcHoldTime, 200_ms);
+  advanceClocks(10_ms, 5);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+}
+
+BOOST_FIXTURE_TEST_CASE(AnnounceChangesOnly, RoutingTableFixture)
+{
+  auto expiration = time::system_clock::now() + 3600_s;
+  auto installOwnAdjLsa = [&] (uint64_t seqNo, double linkCost) {
+    AdjacencyList adjacencies;
+    adjacencies.insert(Adjacent(ROUTER2_NAME, ROUTER2_FACE, linkCost,
+                                Adjacent::STATUS_ACTIVE, 0, 0));
+    conf.getAdjacencyList() = adjacencies;
+    lsdb.installLsa(std::make_shared<AdjLsa>(conf.getRouterPrefix(), seqNo, expiration,
+                                             adjacencies));
+  };
+  installOwnAdjLsa(1, 10);
+  AdjacencyList router2Adjacencies;
+  router2Adjacencies.insert(Adjacent(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1:6363"),
+                                     10, Adjacent::STATUS_ACTIVE, 0, 0));
+  lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER2_NAME, 1, expiration, router2Adjacencies));
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER2_NAME, 1, expiration, NamePrefixList()));
+
+  std::vector<RoutingTableDiff> diffs;
+  rt.afterRoutingChange.connect([&] (const auto& diff) { diffs.push_back(diff); });
+
+  rt.calculate();
+  BOOST_REQUIRE_EQUAL(diffs.size(), 1);
+  BOOST_REQUIRE_EQUAL(diffs.back().added.size(), 1);
+  BOOST_CHECK_EQUAL(diffs.back().added.front().destination, ROUTER2_NAME);
+  BOOST_CHECK_EQUAL(diffs.back().added.front().newNexthops.size(), 1);
+  BOOST_CHECK(diffs.back().removed.empty());
+  BOOST_CHECK(diffs.back().changed.empty());
+
+  // Nothing is announced when the calculation gives the same table
+  rt.calculate();
+  BOOST_CHECK_EQUAL(diffs.size(), 1);
+
+  installOwnAdjLsa(2, 20);
+  rt.calculate();
+  BOOST_REQUIRE_EQUAL(diffs.size(), 2);
+  BOOST_CHECK(diffs.back().added.empty());
+  BOOST_REQUIRE_EQUAL(diffs.back().changed.size(), 1);
+  const auto& change = diffs.back().changed.front();
+  BOOST_CHECK_EQUAL(change.destination, ROUTER2_NAME);
+  BOOST_CHECK_NE(change.oldNexthops, change.newNexthops);
+}
+
+BOOST_FIXTURE_TEST_CASE(AsyncCalculation, AsyncRoutingTableFixture)
+{
+  int nNotifications = 0;
+  asyncRt->afterRoutingChange.connect([&] (const auto&) { ++nNotifications; });
+
+  // The result is only installed once the main thread handles it
+  asyncRt->calculate();
+  BOOST_CHECK(asyncRt->m_isRoutingTableCalculating);
+  BOOST_CHECK(asyncRt->findRoutingTableEntry(ROUTER2_NAME) == nullptr);
+  BOOST_CHECK_EQUAL(nNotifications, 0);
+
+  finishCalculation();
+  BOOST_CHECK(!asyncRt->m_isRoutingTableCalculating);
+  BOOST_CHECK(asyncRt->findRoutingTableEntry(ROUTER2_NAME) != nullptr);
+  BOOST_CHECK_EQUAL(nNotifications, 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(AsyncCalculationCancelled, AsyncRoutingTableFixture)
+{
+  int nNotifications = 0;
+  asyncRt->afterRoutingChange.connect([&] (const auto&) { ++nNotifications; });
+  int nScheduled = 0;
+  int nSaved = 0;
+  asyncRt->rtIncrementSignal.connect([&] (Statistics::PacketType type) {
+    if (type == Statistics::PacketType::ROUTING_CALC_SCHEDULED) {
+      ++nScheduled;
+    }
+    else if (type == Statistics::PacketType::ROUTING_CALC_SAVED) {
+      ++nSaved;
+    }
+  });
+
+  asyncRt->calculate();
+  BOOST_REQUIRE(asyncRt->m_isCalculationCancelled != nullptr);
+
+  // The LSDB no longer matches the snapshot being calculated from
+  installRouter2AdjLsa(2, 20);
+  BOOST_CHECK(*asyncRt->m_isCalculationCancelled);
+  BOOST_CHECK(asyncRt->m_isRouteCalculationScheduled);
+  // The change schedules the next calculation exactly once
+  BOOST_CHECK_EQUAL(nScheduled, 1);
+  BOOST_CHECK_EQUAL(nSaved, 0);
+
+  finishCalculation();
+  BOOST_CHECK(!asyncRt->m_isRoutingTableCalculating);
+  BOOST_CHECK(asyncRt->m_isCalculationCancelled == nullptr);
+  BOOST_CHECK(asyncRt->findRoutingTableEntry(ROUTER2_NAME) == nullptr);
+  BOOST_CHECK_EQUAL(nNotifications, 0);
+  BOOST_CHECK_EQUAL(nScheduled, 1);
+  BOOST_CHECK_EQUAL(nSaved, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(AsyncCalculationNameLsa, AsyncRoutingTableFixture)
+{
+  asyncRt->calculate();
+  BOOST_REQUIRE(asyncRt->m_isCalculationCancelled != nullptr);
+
+  // Prefixes do not enter the calculation, so a prefix change leaves it alone
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER2_NAME, 2, expiration,
+                                            NamePrefixList{"/prefix/2"}));
+  BOOST_CHECK(!*asyncRt->m_isCalculationCancelled);
+  BOOST_CHECK(!asyncRt->m_isRouteCalculationScheduled);
+
+  // A new processing time changes the cost of entering the router
+  lsdb.installLsa(std::make_shared<NameLsa>(ROUTER2_NAME, 3, expiration,
+                                            NamePrefixList{"/prefix/2"}, 5.0, 0.0));
+  BOOST_CHECK(*asyncRt->m_isCalculationCancelled);
+  BOOST_CHECK(asyncRt->m_isRouteCalculationScheduled);
+  BOOST_CHECK_EQUAL(asyncRt->m_changedNameLsas.count(ROUTER2_NAME), 1);
+
+  finishCalculation();
+  BOOST_CHECK(asyncRt->findRoutingTableEntry(ROUTER2_NAME) == nullptr);
+}
+
 const uint8_t RoutingTableData1[] = {
   // Header
   0x90, 0x30,
@@ -0,0 +1,571 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/shortest-path.hpp"
+
+#include "adjacent.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <boost/multi_array.hpp>
+
+#include <numeric>
+#include <random>
+#include <set>
+
+namespace nlsr::tests {
+
+namespace {
+
+using AdjMatrix = boost::multi_array<double, 2>;
+
+/**
+ * @brief Reference implementation: Dijkstra's algorithm that re-sorts the whole queue
+ *        on every iteration, as the link-state calculator originally did.
+ */
+DijkstraResult
+calculateDijkstraPathByQueueSort(const AdjMatrix& matrix, int sourceRouter,
+                                 const std::vector<double>& nodeCost)
+{
+  size_t nRouters = matrix.shape()[0];
+
+  std::vector<int> parent(nRouters, EMPTY_PARENT);
+  std::vector<double> distance(nRouters, INF_DISTANCE);
+  std::vector<int> q(nRouters);
+
+  distance[sourceRouter] = 0;
+  for (size_t i = 0; i < nRouters; ++i) {
+    q[i] = i;
+  }
+
+  for (size_t start = 0; start < nRouters; ++start) {
+    for (size_t i = start; i < nRouters; ++i) {
+      for (size_t j = i + 1; j < nRouters; ++j) {
+        if (distance[q[j]] < distance[q[i]]) {
+          std::swap(q[i], q[j]);
+        }
+      }
+    }
+
+    int u = q[start];
+    for (size_t v = 0; v < nRouters; ++v) {
+      bool isNotExplored = std::find(q.begin() + start + 1, q.end(), static_cast<int>(v)) != q.end();
+      if (matrix[u][v] != Adjacent::NON_ADJACENT_COST && isNotExplored) {
+        double linkCost = matrix[u][v] + nodeCost[v];
+        if (distance[u] + linkCost < distance[v]) {
+          distance[v] = distance[u] + linkCost;
+          parent[v] = u;
+        }
+      }
+    }
+  }
+
+  return DijkstraResult{std::move(parent), std::move(distance)};
+}
+
+/**
+ * @brief Find the first hop toward @p dest by walking the parent links of @p tree .
+ */
+int
+getNextHopByParentChain(const DijkstraResult& tree, int dest, int source)
+{
+  int nextHop = NO_NEXT_HOP;
+  while (tree.parent[dest] != EMPTY_PARENT) {
+    nextHop = dest;
+    dest = tree.parent[dest];
+  }
+  return dest == source ? nextHop : NO_NEXT_HOP;
+}
+
+AdjMatrix
+makeRandomTopology(std::mt19937& rng, size_t nRouters, double linkProbability)
+{
+  AdjMatrix matrix(boost::extents[nRouters][nRouters]);
+  std::fill_n(matrix.origin(), matrix.num_elements(), Adjacent::NON_ADJACENT_COST);
+
+  std::bernoulli_distribution hasLink(linkProbability);
+  std::uniform_int_distribution<int> linkCost(0, 100);
+  for (size_t i = 0; i < nRouters; ++i) {
+    for (size_t j = i + 1; j < nRouters; ++j) {
+      if (hasLink(rng)) {
+        matrix[i][j] = matrix[j][i] = linkCost(rng);
+      }
+    }
+  }
+  return matrix;
+}
+
+/**
+ * @brief Convert @p matrix to a TopologyGraph.
+ * @param onlyNeighbor If not @c NO_NEXT_HOP , every link of @p source except the
+ *                     one to this neighbor is left out, as the link-state calculator used to
+ *                     simulate having only one accessible neighbor.
+ */
+TopologyGraph
+makeGraph(const AdjMatrix& matrix, int source = 0, int onlyNeighbor = NO_NEXT_HOP)
+{
+  size_t nRouters = matrix.shape()[0];
+  std::vector<TopologyGraph::AnnouncedLink> links;
+  for (size_t i = 0; i < nRouters; ++i) {
+    for (size_t j = 0; j < nRouters; ++j) {
+      if (onlyNeighbor != NO_NEXT_HOP && static_cast<int>(i) == source &&
+          static_cast<int>(j) != onlyNeighbor) {
+        continue;
+      }
+      if (matrix[i][j] != Adjacent::NON_ADJACENT_COST) {
+        links.push_back({static_cast<int32_t>(i), static_cast<int32_t>(j), matrix[i][j]});
+      }
+    }
+  }
+  return TopologyGraph::createFromAnnouncedLinks(nRouters, std::move(links));
+}
+
+/**
+ * @brief Find every first hop that starts a shortest path from @p source to each router.
+ * @param distance Shortest distances from @p source .
+ * @pre Every link costs more than zero, so that a parent is always strictly closer.
+ */
+std::vector<std::set<int>>
+getEqualCostFirstHops(const AdjMatrix& matrix, int source, const std::vector<double>& nodeCost,
+                      const std::vector<double>& distance)
+{
+  size_t nRouters = matrix.shape()[0];
+  std::vector<int> order(nRouters);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&] (int a, int b) { return distance[a] < distance[b]; });
+
+  std::vector<std::set<int>> firstHops(nRouters);
+  for (int v : order) {
+    if (v == source || distance[v] == INF_DISTANCE) {
+      continue;
+    }
+    for (size_t u = 0; u < nRouters; ++u) {
+      if (matrix[u][v] != Adjacent::NON_ADJACENT_COST &&
+          distance[u] + matrix[u][v] + nodeCost[v] == distance[v]) {
+        if (static_cast<int>(u) == source) {
+          firstHops[v].insert(v);
+        }
+        else {
+          firstHops[v].insert(firstHops[u].begin(), firstHops[u].end());
+        }
+      }
+    }
+  }
+  return firstHops;
+}
+
+/**
+ * @brief Compare a tree with the reference implementation where paths of equal cost exist.
+ *
+ * Among equal-cost paths, calculateDijkstraPath takes the one with the fewest hops, then the
+ * lowest mapping numbers, while the reference takes whichever its queue order reaches first.
+ * Both must find the same distances and a first hop on a shortest path, and they must agree
+ * wherever only one first hop gives the shortest distance.
+ */
+void
+checkEqualCostTree(const AdjMatrix& matrix, int source, const std::vector<double>& nodeCost)
+{
+  size_t nRouters = matrix.shape()[0];
+  auto expected = calculateDijkstraPathByQueueSort(matrix, source, nodeCost);
+  auto actual = calculateDijkstraPath(makeGraph(matrix), source, nodeCost);
+  BOOST_TEST(actual.distance == expected.distance, boost::test_tools::per_element());
+
+  auto firstHops = getEqualCostFirstHops(matrix, source, nodeCost, expected.distance);
+  for (size_t dest = 0; dest < nRouters; ++dest) {
+    int expectedNextHop = getNextHopByParentChain(expected, dest, source);
+    if (firstHops[dest].empty()) {
+      BOOST_CHECK_EQUAL(actual.getNextHop(dest), NO_NEXT_HOP);
+      BOOST_CHECK_EQUAL(expectedNextHop, NO_NEXT_HOP);
+      continue;
+    }
+
+    BOOST_TEST_CONTEXT("Destination " << dest) {
+      BOOST_CHECK_EQUAL(firstHops[dest].count(actual.getNextHop(dest)), 1);
+      BOOST_CHECK_EQUAL(firstHops[dest].count(expectedNextHop), 1);
+      if (firstHops[dest].size() == 1) {
+        BOOST_CHECK_EQUAL(actual.getNextHop(dest), expectedNextHop);
+      }
+
+      // No equal-cost path of the reference is shorter in hops
+      uint32_t expectedHops = 0;
+      for (int v = dest; v != source; v = expected.parent[v]) {
+        ++expectedHops;
+      }
+      BOOST_CHECK_LE(actual.hops[dest], expectedHops);
+    }
+  }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(TestShortestPath)
+
+BOOST_AUTO_TEST_CASE(Triangle)
+{
+  //   0 --5-- 1
+  //    \     /
+  //    10   2
+  //      \ /
+  //       2
+  auto graph = TopologyGraph::createFromAnnouncedLinks(3, {
+    {0, 1, 5}, {1, 0, 5},
+    {0, 2, 10}, {2, 0, 10},
+    {1, 2, 2}, {2, 1, 2},
+  });
+
+  auto dr = calculateDijkstraPath(graph, 0, {0, 0, 0});
+  BOOST_CHECK_EQUAL(dr.distance[0], 0);
+  BOOST_CHECK_EQUAL(dr.distance[1], 5);
+  BOOST_CHECK_EQUAL(dr.distance[2], 7);
+  BOOST_CHECK_EQUAL(dr.getNextHop(1), 1);
+  BOOST_CHECK_EQUAL(dr.getNextHop(2), 1);
+
+  // A high cost of entering router 1 makes the direct link to router 2 preferable
+  dr = calculateDijkstraPath(graph, 0, {0, 4, 0});
+  BOOST_CHECK_EQUAL(dr.distance[1], 9);
+  BOOST_CHECK_EQUAL(dr.distance[2], 10);
+  BOOST_CHECK_EQUAL(dr.getNextHop(2), 2);
+
+  // Every router is reachable through either neighbor
+  auto mr = calculateMultipathDijkstraPath(graph, 0, {0, 0, 0}, {1, 2});
+  BOOST_CHECK_EQUAL(mr.getDistance(0, 1), 5);
+  BOOST_CHECK_EQUAL(mr.getDistance(0, 2), 7);
+  BOOST_CHECK_EQUAL(mr.getDistance(1, 1), 12);
+  BOOST_CHECK_EQUAL(mr.getDistance(1, 2), 10);
+  BOOST_CHECK_EQUAL(mr.getNextHop(0, 2), 1);
+  BOOST_CHECK_EQUAL(mr.getNextHop(1, 1), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Unreachable)
+{
+  auto graph = TopologyGraph::createFromAnnouncedLinks(3, {{0, 1, 5}, {1, 0, 5}});
+
+  auto dr = calculateDijkstraPath(graph, 0, {0, 0, 0});
+  BOOST_CHECK_EQUAL(dr.distance[2], INF_DISTANCE);
+  BOOST_CHECK_EQUAL(dr.parent[2], EMPTY_PARENT);
+  BOOST_CHECK_EQUAL(dr.getNextHop(2), NO_NEXT_HOP);
+
+  auto mr = calculateMultipathDijkstraPath(graph, 0, {0, 0, 0}, {1});
+  BOOST_CHECK_EQUAL(mr.getDistance(0, 2), INF_DISTANCE);
+  BOOST_CHECK_EQUAL(mr.getNextHop(0, 2), NO_NEXT_HOP);
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithQueueSort)
+{
+  std::mt19937 rng(2024);
+  std::uniform_int_distribution<size_t> nRoutersDist(1, 80);
+  std::uniform_real_distribution<double> linkProbabilityDist(0.02, 0.3);
+  std::uniform_real_distribution<double> nodeCostDist(0.0, 10.0);
+
+  for (int run = 0; run < 200; ++run) {
+    size_t nRouters = nRoutersDist(rng);
+    auto matrix = makeRandomTopology(rng, nRouters, linkProbabilityDist(rng));
+    std::vector<double> nodeCost(nRouters);
+    for (auto& cost : nodeCost) {
+      cost = nodeCostDist(rng);
+    }
+    int source = std::uniform_int_distribution<int>(0, nRouters - 1)(rng);
+
+    auto expected = calculateDijkstraPathByQueueSort(matrix, source, nodeCost);
+    auto actual = calculateDijkstraPath(makeGraph(matrix), source, nodeCost);
+
+    BOOST_TEST_CONTEXT("Run " << run << " with " << nRouters << " routers, source " << source) {
+      BOOST_TEST(actual.distance == expected.distance, boost::test_tools::per_element());
+      for (size_t dest = 0; dest < nRouters; ++dest) {
+        BOOST_CHECK_EQUAL(actual.getNextHop(dest),
+                          getNextHopByParentChain(expected, dest, source));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithQueueSortIntegerCosts)
+{
+  std::mt19937 rng(2025);
+  std::uniform_int_distribution<size_t> nRoutersDist(1, 60);
+  std::uniform_real_distribution<double> linkProbabilityDist(0.05, 0.4);
+  // Small integer costs produce many equal-cost paths
+  std::uniform_int_distribution<int> costDist(1, 4);
+  std::uniform_int_distribution<int> nodeCostDist(0, 2);
+
+  for (int run = 0; run < 200; ++run) {
+    size_t nRouters = nRoutersDist(rng);
+    auto matrix = makeRandomTopology(rng, nRouters, linkProbabilityDist(rng));
+    for (size_t i = 0; i < nRouters; ++i) {
+      for (size_t j = i + 1; j < nRouters; ++j) {
+        if (matrix[i][j] != Adjacent::NON_ADJACENT_COST) {
+          matrix[i][j] = matrix[j][i] = costDist(rng);
+        }
+      }
+    }
+    std::vector<double> nodeCost(nRouters);
+    for (auto& cost : nodeCost) {
+      cost = nodeCostDist(rng);
+    }
+    int source = std::uniform_int_distribution<int>(0, nRouters - 1)(rng);
+
+    BOOST_TEST_CONTEXT("Run " << run << " with " << nRouters << " routers, source " << source) {
+      checkEqualCostTree(matrix, source, nodeCost);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithQueueSortEqualCostMesh)
+{
+  // 6x6 grid where every link costs the same
+  const size_t side = 6;
+  AdjMatrix grid(boost::extents[side * side][side * side]);
+  std::fill_n(grid.origin(), grid.num_elements(), Adjacent::NON_ADJACENT_COST);
+  for (size_t row = 0; row < side; ++row) {
+    for (size_t col = 0; col < side; ++col) {
+      size_t i = row * side + col;
+      if (col + 1 < side) {
+        grid[i][i + 1] = grid[i + 1][i] = 10;
+      }
+      if (row + 1 < side) {
+        grid[i][i + side] = grid[i + side][i] = 10;
+      }
+    }
+  }
+  std::vector<double> gridNodeCost(side * side, 0.0);
+
+  // Full mesh where every link costs the same, and routers cost the same to enter
+  const size_t meshSize = 8;
+  AdjMatrix mesh(boost::extents[meshSize][meshSize]);
+  std::fill_n(mesh.origin(), mesh.num_elements(), Adjacent::NON_ADJACENT_COST);
+  for (size_t i = 0; i < meshSize; ++i) {
+    for (size_t j = 0; j < meshSize; ++j) {
+      if (i != j) {
+        mesh[i][j] = 5;
+      }
+    }
+  }
+  std::vector<double> meshNodeCost(meshSize, 1.0);
+
+  for (size_t source = 0; source < side * side; ++source) {
+    BOOST_TEST_CONTEXT("Grid, source " << source) {
+      checkEqualCostTree(grid, source, gridNodeCost);
+    }
+  }
+  for (size_t source = 0; source < meshSize; ++source) {
+    BOOST_TEST_CONTEXT("Mesh, source " << source) {
+      checkEqualCostTree(mesh, source, meshNodeCost);
+    }
+  }
+
+  // In the grid, every next hop toward the opposite corner is a shortest one; the tie is
+  // broken toward the lower mapping number
+  auto tree = calculateDijkstraPath(makeGraph(grid), 0, gridNodeCost);
+  BOOST_CHECK_EQUAL(tree.distance[side * side - 1], 10 * 2 * (side - 1));
+  BOOST_CHECK_EQUAL(tree.getNextHop(side * side - 1), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MultipathCompareWithOneNeighbor)
+{
+  std::mt19937 rng(2024);
+  std::uniform_int_distribution<size_t> nRoutersDist(2, 60);
+  std::uniform_real_distribution<double> linkProbabilityDist(0.05, 0.4);
+  std::uniform_real_distribution<double> nodeCostDist(0.0, 10.0);
+
+  for (int run = 0; run < 100; ++run) {
+    size_t nRouters = nRoutersDist(rng);
+    auto matrix = makeRandomTopology(rng, nRouters, linkProbabilityDist(rng));
+    std::vector<double> nodeCost(nRouters);
+    for (auto& cost : nodeCost) {
+      cost = nodeCostDist(rng);
+    }
+    int source = std::uniform_int_distribution<int>(0, nRouters - 1)(rng);
+
+    std::vector<int> neighbors;
+    for (size_t i = 0; i < nRouters; ++i) {
+      if (matrix[source][i] != Adjacent::NON_ADJACENT_COST) {
+        neighbors.push_back(i);
+      }
+    }
+    auto mr = calculateMultipathDijkstraPath(makeGraph(matrix), source, nodeCost, neighbors);
+
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      auto expected = calculateDijkstraPath(makeGraph(matrix, source, neighbors[k]), source,
+                                            nodeCost);
+      BOOST_TEST_CONTEXT("Run " << run << " with " << nRouters << " routers, source " << source <<
+                         ", neighbor " << neighbors[k]) {
+        for (size_t dest = 0; dest < nRouters; ++dest) {
+          BOOST_CHECK_EQUAL(mr.getDistance(k, dest), expected.distance[dest]);
+          if (static_cast<int>(dest) != source) {
+            BOOST_CHECK_EQUAL(mr.getNextHop(k, dest), expected.getNextHop(dest));
+          }
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DiffTopology)
+{
+  auto oldGraph = TopologyGraph::createFromAnnouncedLinks(3, {
+    {0, 1, 5}, {1, 0, 5},
+    {1, 2, 2}, {2, 1, 2},
+  });
+  auto newGraph = TopologyGraph::createFromAnnouncedLinks(3, {
+    {0, 1, 7}, {1, 0, 7},
+    {0, 2, 1}, {2, 0, 1},
+  });
+
+  auto changes = diffTopology(oldGraph, newGraph, {0, 0, 0}, {0, 0, 1});
+  BOOST_REQUIRE_EQUAL(changes.size(), 6);
+  BOOST_CHECK_EQUAL(changes[0].from, 0);
+  BOOST_CHECK_EQUAL(changes[0].to, 1);
+  BOOST_CHECK_EQUAL(changes[0].oldCost, 5);
+  BOOST_CHECK_EQUAL(changes[0].newCost, 7);
+  BOOST_CHECK_EQUAL(changes[1].to, 2);
+  BOOST_CHECK_EQUAL(changes[1].oldCost, INF_DISTANCE);
+  BOOST_CHECK_EQUAL(changes[1].newCost, 2);
+  BOOST_CHECK_EQUAL(changes[3].from, 1);
+  BOOST_CHECK_EQUAL(changes[3].to, 2);
+  BOOST_CHECK_EQUAL(changes[3].newCost, INF_DISTANCE);
+
+  BOOST_CHECK(diffTopology(newGraph, newGraph, {0, 0, 1}, {0, 0, 1}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalCompareWithFull)
+{
+  std::mt19937 rng(2024);
+  std::uniform_int_distribution<size_t> nRoutersDist(2, 60);
+  std::uniform_real_distribution<double> linkProbabilityDist(0.05, 0.3);
+  // Small integer costs produce many equal-cost paths, which exercises tie-breaking
+  std::uniform_int_distribution<int> costDist(0, 5);
+  std::uniform_int_distribution<int> nodeCostDist(0, 3);
+
+  for (int run = 0; run < 100; ++run) {
+    size_t nRouters = nRoutersDist(rng);
+    auto matrix = makeRandomTopology(rng, nRouters, linkProbabilityDist(rng));
+    for (size_t i = 0; i < nRouters; ++i) {
+      for (size_t j = i + 1; j < nRouters; ++j) {
+        if (matrix[i][j] != Adjacent::NON_ADJACENT_COST) {
+          matrix[i][j] = matrix[j][i] = costDist(rng);
+        }
+      }
+    }
+    std::vector<double> nodeCost(nRouters);
+    for (auto& cost : nodeCost) {
+      cost = nodeCostDist(rng);
+    }
+    int source = std::uniform_int_distribution<int>(0, nRouters - 1)(rng);
+    int firstHop = std::uniform_int_distribution<int>(0, nRouters - 1)(rng);
+    if (matrix[source][firstHop] == Adjacent::NON_ADJACENT_COST) {
+      firstHop = NO_NEXT_HOP;
+    }
+
+    auto graph = makeGraph(matrix);
+    auto tree = calculateDijkstraPath(graph, source, nodeCost);
+    auto restrictedTree = firstHop == NO_NEXT_HOP ? tree :
+                          calculateMultipathDijkstraPath(graph, source, nodeCost, {firstHop}).trees[0];
+
+    for (int round = 0; round < 10; ++round) {
+      auto oldNodeCost = nodeCost;
+      std::uniform_int_distribution<int> routerDist(0, nRouters - 1);
+      int nChanges = std::uniform_int_distribution<int>(1, 3)(rng);
+      for (int c = 0; c < nChanges; ++c) {
+        int i = routerDist(rng);
+        int j = routerDist(rng);
+        if (i == j) {
+          nodeCost[i] = nodeCostDist(rng);
+        }
+        else if (matrix[i][j] != Adjacent::NON_ADJACENT_COST && costDist(rng) == 0) {
+          matrix[i][j] = matrix[j][i] = Adjacent::NON_ADJACENT_COST;
+        }
+        else {
+          matrix[i][j] = matrix[j][i] = costDist(rng);
+        }
+      }
+
+      auto newGraph = makeGraph(matrix);
+      auto changes = diffTopology(graph, newGraph, oldNodeCost, nodeCost);
+      graph = std::move(newGraph);
+
+      updateDijkstraPath(tree, graph, nodeCost, changes, source);
+      auto expected = calculateDijkstraPath(graph, source, nodeCost);
+
+      updateDijkstraPath(restrictedTree, graph, nodeCost, changes, source, firstHop);
+      auto expectedRestricted = firstHop == NO_NEXT_HOP ? expected :
+        calculateMultipathDijkstraPath(graph, source, nodeCost, {firstHop}).trees[0];
+
+      BOOST_TEST_CONTEXT("Run " << run << " round " << round << ", source " << source <<
+                         ", first hop " << firstHop) {
+        BOOST_TEST(tree.distance == expected.distance, boost::test_tools::per_element());
+        BOOST_TEST(tree.hops == expected.hops, boost::test_tools::per_element());
+        BOOST_TEST(tree.parent == expected.parent, boost::test_tools::per_element());
+        BOOST_TEST(tree.firstHop == expected.firstHop, boost::test_tools::per_element());
+        BOOST_TEST(restrictedTree.distance == expectedRestricted.distance,
+                   boost::test_tools::per_element());
+        BOOST_TEST(restrictedTree.parent == expectedRestricted.parent,
+                   boost::test_tools::per_element());
+        BOOST_TEST(restrictedTree.firstHop == expectedRestricted.firstHop,
+                   boost::test_tools::per_element());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LoopFreeAlternates)
+{
+  //   0 --1-- 1
+  //   |       |
+  //   1       1
+  //   |       |
+  //   2 --c-- 3
+  auto makeSquare = [] (double cost23) {
+    return TopologyGraph::createFromAnnouncedLinks(4, {
+      {0, 1, 1}, {1, 0, 1},
+      {0, 2, 1}, {2, 0, 1},
+      {1, 3, 1}, {3, 1, 1},
+      {2, 3, cost23}, {3, 2, cost23},
+    });
+  };
+  std::vector<double> nodeCost{0, 0, 0, 0};
+  std::vector<int> neighbors{1, 2};
+
+  // Router 2 reaches 3 directly at cost 2 < 1 + 2, so it is an alternate toward 3.
+  // The primary next hop toward 1 and 2 is the destination itself; the other neighbor
+  // would send traffic back through 0.
+  auto graph = makeSquare(2);
+  auto primary = calculateDijkstraPath(graph, 0, nodeCost);
+  BOOST_CHECK_EQUAL(primary.getNextHop(3), 1);
+  std::vector<DijkstraResult> neighborTrees{calculateDijkstraPath(graph, 1, nodeCost),
+                                            calculateDijkstraPath(graph, 2, nodeCost)};
+  auto alternates = calculateLoopFreeAlternates(graph, 0, nodeCost, primary, neighbors,
+                                                neighborTrees);
+  BOOST_TEST(alternates == std::vector<int>({NO_NEXT_HOP, NO_NEXT_HOP, NO_NEXT_HOP, 2}),
+             boost::test_tools::per_element());
+
+  // At cost 3, router 2 has an equal-cost path to 3 through 0, so it is not loop-free
+  graph = makeSquare(3);
+  primary = calculateDijkstraPath(graph, 0, nodeCost);
+  neighborTrees = {calculateDijkstraPath(graph, 1, nodeCost),
+                   calculateDijkstraPath(graph, 2, nodeCost)};
+  alternates = calculateLoopFreeAlternates(graph, 0, nodeCost, primary, neighbors,
+                                           neighborTrees);
+  BOOST_CHECK_EQUAL(alternates[3], NO_NEXT_HOP);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
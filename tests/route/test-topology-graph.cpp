@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/topology-graph.hpp"
+
+#include "adjacent.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestTopologyGraph)
+
+BOOST_AUTO_TEST_CASE(Symmetric)
+{
+  auto graph = TopologyGraph::createFromAnnouncedLinks(3, {
+    {2, 0, 7}, {0, 2, 7},
+    {1, 0, 5}, {0, 1, 5},
+  });
+
+  BOOST_CHECK_EQUAL(graph.size(), 3);
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 4);
+
+  // Links of router 0 are sorted by neighbor
+  BOOST_REQUIRE_EQUAL(graph.linksEnd(0) - graph.linksBegin(0), 2);
+  BOOST_CHECK_EQUAL(graph.getNeighbor(graph.linksBegin(0)), 1);
+  BOOST_CHECK_EQUAL(graph.getCost(graph.linksBegin(0)), 5);
+  BOOST_CHECK_EQUAL(graph.getNeighbor(graph.linksBegin(0) + 1), 2);
+  BOOST_CHECK_EQUAL(graph.getCost(graph.linksBegin(0) + 1), 7);
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 0), 5);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(2, 0), 7);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 2), Adjacent::NON_ADJACENT_COST);
+}
+
+BOOST_AUTO_TEST_CASE(AsymmetricCost)
+{
+  auto graph = TopologyGraph::createFromAnnouncedLinks(2, {{0, 1, 5}, {1, 0, 10}});
+
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 1), 10);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 0), 10);
+}
+
+BOOST_AUTO_TEST_CASE(BrokenLink)
+{
+  // 0-1 is announced in one direction only; 1-2 is broken on one side
+  auto graph = TopologyGraph::createFromAnnouncedLinks(3, {
+    {0, 1, 5},
+    {1, 2, 5}, {2, 1, Adjacent::NON_ADJACENT_COST},
+  });
+
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 0);
+  for (int32_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_EQUAL(graph.linksBegin(i), graph.linksEnd(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DuplicateAndSelfLink)
+{
+  auto graph = TopologyGraph::createFromAnnouncedLinks(2, {
+    {0, 0, 1},
+    {0, 1, 5}, {1, 0, 3}, {0, 1, 3},
+  });
+
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 2);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 0), Adjacent::NON_ADJACENT_COST);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(0, 1), 3);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(1, 0), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
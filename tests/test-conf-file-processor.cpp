@@ -20,10 +20,12 @@
  **/
 
 #include "conf-file-processor.hpp"
+#include "update/prefix-journal.hpp"
 
 #include "tests/boost-test.hpp"
 #include "tests/io-key-chain-fixture.hpp"
 
+#include <filesystem>
 #include <fstream>
 #include <boost/algorithm/string.hpp>
 
@@ -39,6 +41,9 @@ const std::string SECTION_GENERAL =
   "  router /cs/pollux\n"
   "  lsa-refresh-time 1800\n"
   "  lsa-interest-lifetime 3\n"
+  "  max-concurrent-lsa-fetches 8\n"
+  "  name-lsa-build-interval 50\n"
+  "  name-lsa-deltas on\n"
   "  router-dead-interval 86400\n"
   "  sync-protocol psync\n"
   "  sync-interest-lifetime 10000\n"
@@ -105,6 +110,17 @@ const std::string SECTION_FIB =
   "{\n"
   "   max-faces-per-prefix 3\n"
   "   routing-calc-interval 9\n"
+  "   routing-calc-initial-wait 100\n"
+  "   routing-calc-increment 500\n"
+  "}\n\n";
+
+const std::string SECTION_ROUTING =
+  "routing\n"
+  "{\n"
+  "   worker-threads 4\n"
+  "   incremental-spf validate\n"
+  "   fast-reroute on\n"
+  "   async-calculation on\n"
   "}\n\n";
 
 const std::string SECTION_ADVERTISING =
@@ -117,7 +133,8 @@ const std::string SECTION_ADVERTISING =
 // NEED TO TEST SECURITY SECTION SUCH AS LOADING CERTIFICATE
 
 const std::string CONFIG_LINK_STATE = SECTION_GENERAL + SECTION_NEIGHBORS +
-                                      SECTION_HYPERBOLIC_OFF + SECTION_FIB + SECTION_ADVERTISING;
+                                      SECTION_HYPERBOLIC_OFF + SECTION_FIB + SECTION_ROUTING +
+                                      SECTION_ADVERTISING;
 
 const std::string CONFIG_HYPERBOLIC = SECTION_GENERAL + SECTION_NEIGHBORS +
                                       SECTION_HYPERBOLIC_ON + SECTION_FIB + SECTION_ADVERTISING;
@@ -182,6 +199,9 @@ BOOST_AUTO_TEST_CASE(LinkState)
   BOOST_CHECK_EQUAL(conf.getLsaRefreshTime(), 1800);
   BOOST_CHECK(conf.getSyncProtocol() == SyncProtocol::PSYNC);
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(), ndn::time::seconds(3));
+  BOOST_CHECK_EQUAL(conf.getMaxConcurrentLsaFetches(), 8);
+  BOOST_CHECK_EQUAL(conf.getNameLsaBuildInterval(), ndn::time::milliseconds(50));
+  BOOST_CHECK_EQUAL(conf.isNameLsaDeltasEnabled(), true);
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), 86400);
   BOOST_CHECK_EQUAL(conf.getSyncInterestLifetime(), ndn::time::milliseconds(10000));
   BOOST_CHECK_EQUAL(conf.getStateFileDir(), "/tmp");
@@ -213,11 +233,37 @@ BOOST_AUTO_TEST_CASE(LinkState)
   // FIB
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 3);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(), 9);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialWait(), 100);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcIncrement(), 500);
+
+  // Routing
+  BOOST_CHECK_EQUAL(conf.getRoutingWorkerThreads(), 4);
+  BOOST_CHECK_EQUAL(conf.getIncrementalSpfState(), INCREMENTAL_SPF_VALIDATE);
+  BOOST_CHECK_EQUAL(conf.isFastRerouteEnabled(), true);
+  BOOST_CHECK_EQUAL(conf.isAsyncCalculationEnabled(), true);
 
   // Advertising
   BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(SavedPrefixes)
+{
+  // Prefixes saved at runtime are advertised along with the advertising section
+  std::string journalFile = update::makePrefixJournalFileName("/tmp/nlsr.conf");
+  std::ofstream journal(journalFile);
+  journal << "+ /saved/prefix\n"
+          << "+ /deleted/prefix\n"
+          << "- /deleted/prefix\n";
+  journal.close();
+
+  BOOST_REQUIRE(processConfigurationString(CONFIG_LINK_STATE));
+  std::filesystem::remove(journalFile);
+
+  BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 3);
+  BOOST_CHECK(conf.getNamePrefixList().contains("/saved/prefix"));
+  BOOST_CHECK(!conf.getNamePrefixList().contains("/deleted/prefix"));
+}
+
 BOOST_AUTO_TEST_CASE(SvsPrefix)
 {
 #ifdef HAVE_SVS
@@ -278,6 +324,9 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
 
   commentOut("lsa-refresh-time", config);
   commentOut("lsa-interest-lifetime", config);
+  commentOut("max-concurrent-lsa-fetches", config);
+  commentOut("name-lsa-build-interval", config);
+  commentOut("name-lsa-deltas", config);
   commentOut("router-dead-interval", config);
 
   BOOST_REQUIRE(processConfigurationString(config));
@@ -285,6 +334,11 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(conf.getLsaRefreshTime(), static_cast<uint32_t>(LSA_REFRESH_TIME_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(),
                     static_cast<ndn::time::seconds>(LSA_INTEREST_LIFETIME_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getMaxConcurrentLsaFetches(),
+                    static_cast<uint32_t>(MAX_CONCURRENT_LSA_FETCHES_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getNameLsaBuildInterval(),
+                    ndn::time::milliseconds(NAME_LSA_BUILD_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.isNameLsaDeltasEnabled(), false);
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), (2 * conf.getLsaRefreshTime()));
 
   BOOST_CHECK_NE(conf.m_confFileName, conf.getConfFileNameDynamic());
@@ -344,6 +398,8 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
 
   commentOut("max-faces-per-prefix", config);
   commentOut("routing-calc-interval", config);
+  commentOut("routing-calc-initial-wait", config);
+  commentOut("routing-calc-increment", config);
 
   BOOST_REQUIRE(processConfigurationString(config));
 
@@ -351,6 +407,28 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
                     static_cast<uint32_t>(MAX_FACES_PER_PREFIX_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(),
                     static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialWait(),
+                    static_cast<uint32_t>(ROUTING_CALC_INITIAL_WAIT_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcIncrement(),
+                    static_cast<uint32_t>(ROUTING_CALC_INCREMENT_DEFAULT));
+}
+
+BOOST_AUTO_TEST_CASE(DefaultValuesRouting)
+{
+  std::string config = SECTION_ROUTING;
+
+  commentOut("worker-threads", config);
+  commentOut("incremental-spf", config);
+  commentOut("fast-reroute", config);
+  commentOut("async-calculation", config);
+
+  BOOST_REQUIRE(processConfigurationString(config));
+
+  BOOST_CHECK_EQUAL(conf.getRoutingWorkerThreads(),
+                    static_cast<uint32_t>(ROUTING_WORKER_THREADS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getIncrementalSpfState(), INCREMENTAL_SPF_DEFAULT);
+  BOOST_CHECK_EQUAL(conf.isFastRerouteEnabled(), false);
+  BOOST_CHECK_EQUAL(conf.isAsyncCalculationEnabled(), false);
 }
 
 BOOST_AUTO_TEST_CASE(DefaultValuesHyperbolic)
@@ -73,11 +73,15 @@ public:
     }
     BOOST_CHECK_EQUAL(adjList.findAdjacent(ndn::Name(ACTIVE_NEIGHBOR))->getStatus(),
                       Adjacent::STATUS_ACTIVE);
+    auto nScheduled = nlsr.m_statsCollector.getStatistics()
+                        .get(Statistics::PacketType::ROUTING_CALC_SCHEDULED);
 
     this->advanceClocks(4_s);
     BOOST_CHECK_EQUAL(checkHelloInterests(ACTIVE_NEIGHBOR), 3);
     if (conf.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
-      BOOST_CHECK_EQUAL(nlsr.m_routingTable.m_isRouteCalculationScheduled, true);
+      // The calculation may already have run, as the first one after a quiet period is not delayed
+      BOOST_CHECK_GT(nlsr.m_statsCollector.getStatistics()
+                       .get(Statistics::PacketType::ROUTING_CALC_SCHEDULED), nScheduled);
     }
     else {
       BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_isBuildAdjLsaScheduled, true);
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "highest-seq-no-table.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestHighestSeqNoTable)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  HighestSeqNoTable table;
+  BOOST_CHECK(!table.find("/ndn/site/router1", Lsa::Type::NAME));
+
+  BOOST_CHECK(table.insert("/ndn/site/router1", Lsa::Type::NAME, 10));
+  BOOST_CHECK(table.insert("/ndn/site/router1", Lsa::Type::ADJACENCY, 3));
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router1", Lsa::Type::NAME).value(), 10);
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router1", Lsa::Type::ADJACENCY).value(), 3);
+  BOOST_CHECK(!table.find("/ndn/site/router1", Lsa::Type::COORDINATE));
+  BOOST_CHECK(!table.find("/ndn/site/router2", Lsa::Type::NAME));
+
+  // Same or higher sequence numbers are accepted, lower ones are outdated
+  BOOST_CHECK(table.insert("/ndn/site/router1", Lsa::Type::NAME, 10));
+  BOOST_CHECK(table.insert("/ndn/site/router1", Lsa::Type::NAME, 11));
+  BOOST_CHECK(!table.insert("/ndn/site/router1", Lsa::Type::NAME, 9));
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router1", Lsa::Type::NAME).value(), 11);
+
+  // Sequence number 0 is a known value
+  BOOST_CHECK(table.insert("/ndn/site/router2", Lsa::Type::COORDINATE, 0));
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router2", Lsa::Type::COORDINATE).value(), 0);
+  BOOST_CHECK_EQUAL(table.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  HighestSeqNoTable table;
+  table.insert("/ndn/site/router1", Lsa::Type::NAME, 10);
+  table.insert("/ndn/site/router1", Lsa::Type::ADJACENCY, 3);
+  table.insert("/ndn/site/router2", Lsa::Type::NAME, 7);
+
+  table.erase("/ndn/site/router1", Lsa::Type::NAME);
+  BOOST_CHECK(!table.find("/ndn/site/router1", Lsa::Type::NAME));
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  // The router is reclaimed with its last LSA
+  table.erase("/ndn/site/router1", Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+  table.erase("/ndn/site/router3", Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  // A reused entry starts empty
+  table.insert("/ndn/site/router3", Lsa::Type::NAME, 1);
+  BOOST_CHECK(!table.find("/ndn/site/router3", Lsa::Type::ADJACENCY));
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router3", Lsa::Type::NAME).value(), 1);
+  BOOST_CHECK_EQUAL(table.find("/ndn/site/router2", Lsa::Type::NAME).value(), 7);
+  BOOST_CHECK_EQUAL(table.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestHighestSeqNoTable
+
+} // namespace nlsr::tests
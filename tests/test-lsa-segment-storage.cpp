@@ -139,8 +139,8 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(lsdb.m_lsaStorage.size(), 1);
   BOOST_CHECK_EQUAL(numValidationSignal, 1);
 
-  // Scheduled removal of LSA
-  advanceClocks(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT));
+  // Scheduled removal of LSA, which the timer wheel runs within a second of its due time
+  advanceClocks(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT + 1));
   BOOST_CHECK_EQUAL(lsdb.m_lsaStorage.size(), 0);
 }
 
@@ -20,6 +20,7 @@
  */
 
 #include "lsdb.hpp"
+#include "tlv-nlsr.hpp"
 #include "lsa/lsa.hpp"
 #include "name-prefix-list.hpp"
 
@@ -67,8 +68,8 @@ public:
   void
   checkSignalResult(LsdbUpdate updateType,
                     const std::shared_ptr<Lsa>& lsaPtr,
-                    const std::list<PrefixInfo>& namesToAdd,
-                    const std::list<PrefixInfo>& namesToRemove)
+                    const std::vector<PrefixInfo>& namesToAdd,
+                    const std::vector<PrefixInfo>& namesToRemove)
   {
     BOOST_CHECK(updateHappened);
     BOOST_CHECK_EQUAL(lsaPtrCheck->getOriginRouter(), lsaPtr->getOriginRouter());
@@ -101,8 +102,8 @@ public:
   Lsdb lsdb;
 
   LsdbUpdate updateTypeCheck = LsdbUpdate::INSTALLED;
-  std::list<PrefixInfo> namesToAddCheck;
-  std::list<PrefixInfo> namesToRemoveCheck;
+  std::vector<PrefixInfo> namesToAddCheck;
+  std::vector<PrefixInfo> namesToRemoveCheck;
   std::shared_ptr<Lsa> lsaPtrCheck = nullptr;
   bool updateHappened = false;
 };
@@ -134,10 +135,14 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
 
   auto deadline = ndn::time::steady_clock::now() + ndn::time::seconds(LSA_REFRESH_TIME_MAX);
 
-  // Simulate an LSA interest timeout
+  // Simulate an LSA interest timeout, which ends the fetch
+  BOOST_REQUIRE_EQUAL(lsdb.m_fetchers.size(), 1);
+  lsdb.m_fetchers.begin()->second.fetcher->stop();
+  lsdb.m_fetchers.clear();
   lsdb.onFetchLsaError(ndn::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT, "Timeout",
                        oldInterestName, 0, deadline, interestName, oldSeqNo);
-  advanceClocks(10_ms);
+  // The first retry is within the initial backoff
+  advanceClocks(10_ms, 50);
 
   BOOST_REQUIRE(interests.size() > 0);
 
@@ -177,6 +182,93 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   BOOST_CHECK_EQUAL(interests.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FetchCoalescing)
+{
+  int nCoalesced = 0;
+  int nSuperseded = 0;
+  lsdb.lsaIncrementSignal.connect([&] (Statistics::PacketType type) {
+    if (type == Statistics::PacketType::LSA_FETCH_COALESCED) {
+      ++nCoalesced;
+    }
+    else if (type == Statistics::PacketType::LSA_FETCH_SUPERSEDED) {
+      ++nSuperseded;
+    }
+  });
+
+  ndn::Name lsaName("/ndn/NLSR/LSA/cs/%C1.Router/router2/NAME");
+  auto countInterests = [&] (uint64_t seqNo) {
+    return std::count_if(face.sentInterests.begin(), face.sentInterests.end(),
+                         [&] (const auto& interest) {
+                           return interest.getName().getPrefix(lsaName.size() + 1) ==
+                                  ndn::Name(lsaName).appendNumber(seqNo);
+                         });
+  };
+
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(10), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(countInterests(10), 1);
+
+  // A duplicate notification attaches to the fetch in progress
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(10), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(countInterests(10), 1);
+  BOOST_CHECK_EQUAL(nCoalesced, 1);
+
+  // A newer seq no replaces it
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(11), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(countInterests(11), 1);
+  BOOST_CHECK_EQUAL(nSuperseded, 1);
+  BOOST_REQUIRE_EQUAL(lsdb.m_fetchers.size(), 1);
+  BOOST_CHECK_EQUAL(lsdb.m_fetchers.begin()->second.seqNo, 11);
+
+  // Fetches of other LSAs are independent
+  lsdb.expressInterest(ndn::Name("/ndn/NLSR/LSA/cs/%C1.Router/router3/NAME").appendNumber(10), 0, 0);
+  BOOST_CHECK_EQUAL(lsdb.m_fetchers.size(), 2);
+  BOOST_CHECK_EQUAL(nCoalesced, 1);
+}
+
+BOOST_AUTO_TEST_CASE(FetchPriority)
+{
+  conf.setMaxConcurrentLsaFetches(1);
+  conf.setLsaInterestLifetime(1_s);
+
+  ndn::Name router2("/ndn/NLSR/LSA/cs/%C1.Router/router2");
+  ndn::Name router3("/ndn/NLSR/LSA/cs/%C1.Router/router3");
+  lsdb.expressInterest(ndn::Name(router2).append("NAME").appendNumber(1), 0, 0);
+  lsdb.expressInterest(ndn::Name(router3).append("NAME").appendNumber(1), 0, 0);
+  lsdb.expressInterest(ndn::Name(router3).append("ADJACENCY").appendNumber(1), 0, 0);
+  BOOST_CHECK_EQUAL(lsdb.m_fetchers.size(), 1);
+  BOOST_CHECK_EQUAL(lsdb.m_pendingFetches.size(), 2);
+
+  // A newer seq no replaces a waiting fetch in place
+  lsdb.expressInterest(ndn::Name(router3).append("NAME").appendNumber(2), 0, 0);
+  BOOST_CHECK_EQUAL(lsdb.m_pendingFetches.size(), 2);
+
+  // Once the first fetch times out, the Adjacency LSA goes before the Name LSA queued earlier
+  advanceClocks(100_ms, 15);
+  BOOST_REQUIRE_EQUAL(lsdb.m_fetchers.size(), 1);
+  auto [router, lsaType] = lsdb.m_fetchers.begin()->first;
+  BOOST_CHECK_EQUAL(router, "/ndn/cs/%C1.Router/router3");
+  BOOST_CHECK_EQUAL(lsaType, Lsa::Type::ADJACENCY);
+  BOOST_REQUIRE(!lsdb.m_nameFetchQueue.empty());
+  auto pendingIt = lsdb.m_pendingFetches.find(lsdb.m_nameFetchQueue.front());
+  BOOST_REQUIRE(pendingIt != lsdb.m_pendingFetches.end());
+  BOOST_CHECK_EQUAL(pendingIt->second.interestName,
+                    ndn::Name(router3).append("NAME").appendNumber(2));
+}
+
+BOOST_AUTO_TEST_CASE(FetchRetryDelay)
+{
+  for (uint32_t retransmitNo = 0; retransmitNo < 10; ++retransmitNo) {
+    auto backoff = std::min(Lsdb::LSA_FETCH_RETRY_INITIAL_DELAY * (1 << retransmitNo),
+                            Lsdb::LSA_FETCH_RETRY_MAX_DELAY);
+    auto delay = Lsdb::getLsaFetchRetryDelay(retransmitNo);
+    BOOST_CHECK_GE(delay, backoff / 2);
+    BOOST_CHECK_LE(delay, backoff);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(LsdbSegmentedData)
 {
   // Add a lot of NameLSAs to exceed max packet size
@@ -255,6 +347,49 @@ BOOST_AUTO_TEST_CASE(SegmentLsaData)
   fetcher->stop();
 }
 
+BOOST_AUTO_TEST_CASE(SignedSegmentCache)
+{
+  int nSigned = 0;
+  lsdb.afterSegmentsSigned.connect([&] (size_t) { ++nSigned; });
+
+  auto lsa = lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+  BOOST_REQUIRE(lsa != nullptr);
+  ndn::Name interestName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME/");
+  interestName.appendNumber(lsa->getSeqNo());
+
+  // The LSA is signed once, however many neighbors ask for it
+  face.sentData.clear();
+  lsdb.processInterest(ndn::Name(), ndn::Interest(interestName));
+  lsdb.processInterest(ndn::Name(), ndn::Interest(interestName));
+  BOOST_CHECK_EQUAL(nSigned, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_CHECK_EQUAL(face.sentData[0].wireEncode(), face.sentData[1].wireEncode());
+
+  // Interests for a segment of that version are answered from the cache
+  lsdb.processInterest(ndn::Name(), ndn::Interest(face.sentData[0].getName()));
+  BOOST_CHECK_EQUAL(nSigned, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_EQUAL(face.sentData[2].getName(), face.sentData[0].getName());
+
+  // So are Interests for that version under another form of name
+  lsdb.processInterest(ndn::Name(),
+                       ndn::Interest(ndn::Name(interestName).appendVersion(1).appendSegment(0)));
+  BOOST_CHECK_EQUAL(nSigned, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 4);
+  BOOST_CHECK_EQUAL(face.sentData[3].getName(), face.sentData[0].getName());
+  face.sentData.pop_back();
+
+  // A new version of the LSA is signed again
+  lsdb.buildAndInstallOwnNameLsa();
+  BOOST_CHECK(lsdb.m_segmentedLsas.count(Lsa::Type::NAME) == 0);
+  ndn::Name newInterestName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME/");
+  newInterestName.appendNumber(lsa->getSeqNo());
+  lsdb.processInterest(ndn::Name(), ndn::Interest(newInterestName));
+  BOOST_CHECK_EQUAL(nSigned, 2);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 4);
+  BOOST_CHECK_NE(face.sentData[3].getName(), face.sentData[0].getName());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
 {
   ndn::Name router("/ndn/cs/%C1.Router/router1");
@@ -281,6 +416,99 @@ BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
   BOOST_CHECK_EQUAL(foundLsa->wireEncode(), lsa.wireEncode());
 }
 
+BOOST_AUTO_TEST_CASE(NameLsaDelta)
+{
+  conf.setNameLsaDeltasEnabled(true);
+
+  ndn::Name prefix("/ndn/edu/memphis/netlab/research/nlsr/test/prefix/");
+  for (int i = 0; i < 10; ++i) {
+    conf.getNamePrefixList().insert(ndn::Name(prefix).appendNumber(i));
+  }
+  lsdb.buildAndInstallOwnNameLsa();
+  auto lsa = lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+  BOOST_REQUIRE(lsa != nullptr);
+  uint64_t baseSeqNo = lsa->getSeqNo();
+
+  conf.getNamePrefixList().insert(ndn::Name(prefix).appendNumber(10));
+  lsdb.buildAndInstallOwnNameLsa();
+  conf.getNamePrefixList().erase(ndn::Name(prefix).appendNumber(0));
+  lsdb.buildAndInstallOwnNameLsa();
+  BOOST_CHECK_EQUAL(lsa->getSeqNo(), baseSeqNo + 2);
+
+  // The changes since the base are chained into one delta
+  auto delta = lsdb.buildNameLsaDelta(baseSeqNo);
+  BOOST_REQUIRE(delta != nullptr);
+  BOOST_CHECK_EQUAL(delta->getSeqNo(), baseSeqNo + 2);
+  BOOST_CHECK_EQUAL(*delta->getBaseSeqNo(), baseSeqNo);
+  BOOST_CHECK_EQUAL(delta->getNpl(), NamePrefixList{ndn::Name(prefix).appendNumber(10)});
+  BOOST_CHECK_EQUAL(delta->getRemovedNpl(), NamePrefixList{ndn::Name(prefix).appendNumber(0)});
+  BOOST_CHECK_EQUAL(delta->getProcessingTime(), lsa->getProcessingTime());
+  BOOST_CHECK_EQUAL(delta->getLoadIndex(), lsa->getLoadIndex());
+  // Nothing is saved over the whole LSA, or the base is older than the changes we know
+  BOOST_CHECK(lsdb.buildNameLsaDelta(baseSeqNo - 1) == nullptr);
+  BOOST_CHECK(lsdb.buildNameLsaDelta(baseSeqNo - 2) == nullptr);
+
+  // The delta is served under the name that asks for it
+  ndn::Name deltaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME");
+  deltaName.appendNumber(lsa->getSeqNo()).append("delta").appendNumber(baseSeqNo);
+  face.sentData.clear();
+  lsdb.processInterest(ndn::Name(), ndn::Interest(deltaName));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK(deltaName.isPrefixOf(face.sentData[0].getName()));
+  BOOST_CHECK_EQUAL(face.sentData[0].getContent().blockFromValue(), delta->wireEncode());
+
+  // Without a delta, a short reply sends the receiver to the whole LSA
+  ndn::Name noDeltaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME");
+  noDeltaName.appendNumber(lsa->getSeqNo()).append("delta").appendNumber(baseSeqNo - 2);
+  face.sentData.clear();
+  lsdb.processInterest(ndn::Name(), ndn::Interest(noDeltaName));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK(noDeltaName.isPrefixOf(face.sentData[0].getName()));
+  BOOST_CHECK_EQUAL(face.sentData[0].getContent().blockFromValue(),
+                    ndn::makeEmptyBlock(tlv::NameLsaNoDelta));
+
+  // A receiver that has the base applies the delta
+  ndn::Name router("/ndn/cs/%C1.Router/router1");
+  auto expiration = ndn::time::system_clock::now() + 3600_s;
+  lsdb.installLsa(std::make_shared<NameLsa>(router, 5, expiration,
+                                            NamePrefixList{"/prefix/1", "/prefix/2"}));
+  NameLsa routerDelta(router, 7, expiration, 5, NamePrefixList{"/prefix/3"},
+                      NamePrefixList{"/prefix/1"});
+  ndn::Name interestName("/localhop/ndn/nlsr/LSA/cs/%C1.Router/router1/NAME");
+  lsdb.afterFetchLsa(routerDelta.wireEncode().getBuffer(), ndn::Name(interestName).appendNumber(7));
+  auto routerLsa = lsdb.findLsa<NameLsa>(router);
+  BOOST_REQUIRE(routerLsa != nullptr);
+  BOOST_CHECK_EQUAL(routerLsa->getSeqNo(), 7);
+  BOOST_CHECK_EQUAL(routerLsa->getNpl(), (NamePrefixList{"/prefix/2", "/prefix/3"}));
+
+  // A delta from another version is not applied, the whole LSA is fetched instead
+  face.sentInterests.clear();
+  NameLsa staleDelta(router, 9, expiration, 8, NamePrefixList{"/prefix/4"}, NamePrefixList{});
+  lsdb.afterFetchLsa(staleDelta.wireEncode().getBuffer(), ndn::Name(interestName).appendNumber(9));
+  BOOST_CHECK_EQUAL(routerLsa->getSeqNo(), 7);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests[0].getName(), ndn::Name(interestName).appendNumber(9));
+
+  // Later fetches ask for the delta from the installed version
+  face.sentInterests.clear();
+  lsdb.expressInterest(ndn::Name(interestName).appendNumber(10), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests[0].getName(),
+                    ndn::Name(interestName).appendNumber(10).append("delta").appendNumber(7));
+
+  // A reply without a delta also makes the receiver fetch the whole LSA
+  face.sentInterests.clear();
+  auto noDelta = ndn::makeEmptyBlock(tlv::NameLsaNoDelta);
+  lsdb.afterFetchLsa(std::make_shared<ndn::Buffer>(noDelta.begin(), noDelta.end()),
+                     ndn::Name(interestName).appendNumber(12));
+  BOOST_CHECK_EQUAL(routerLsa->getSeqNo(), 7);
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentInterests[0].getName(), ndn::Name(interestName).appendNumber(12));
+}
+
 BOOST_AUTO_TEST_CASE(LsdbRemoveAndExists)
 {
   auto testTimePoint = ndn::time::system_clock::now();
@@ -309,6 +537,29 @@ BOOST_AUTO_TEST_CASE(LsdbRemoveAndExists)
   BOOST_CHECK_EQUAL(lsdb1.doesLsaExist(router1, Lsa::Type::NAME), false);
 }
 
+BOOST_AUTO_TEST_CASE(HighestSeqNoReclaimed)
+{
+  ndn::Name lsaName("/ndn/NLSR/LSA/site/%C1.Router/router2/NAME");
+  auto [originRouter, lsaType] = lsdb.parseLsaName(lsaName);
+  BOOST_CHECK_EQUAL(originRouter, "/ndn/site/%C1.Router/router2");
+  BOOST_CHECK_EQUAL(lsaType, Lsa::Type::NAME);
+
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(5), 0, 0);
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.find(originRouter, lsaType).value(), 5);
+
+  auto expiration = ndn::time::system_clock::now() + 3600_s;
+  lsdb.installLsa(std::make_shared<NameLsa>(originRouter, 5, expiration, NamePrefixList{}));
+  // A newer LSA is announced before the installed one expires
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(6), 0, 0);
+  lsdb.removeLsa(originRouter, lsaType);
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.find(originRouter, lsaType).value(), 6);
+
+  lsdb.installLsa(std::make_shared<NameLsa>(originRouter, 6, expiration, NamePrefixList{}));
+  lsdb.removeLsa(originRouter, lsaType);
+  BOOST_CHECK(!lsdb.m_highestSeqNo.find(originRouter, lsaType));
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(InstallNameLsa)
 {
   // Install lsa with name1 and name2
@@ -106,6 +106,28 @@ BOOST_AUTO_TEST_CASE(Insert_Erase)
   BOOST_CHECK_EQUAL(list.getSources(name1).size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(Remove_SortedView)
+{
+  NamePrefixList list;
+  list.insert("/ndn/b", "nlsr.conf", 5);
+  list.insert("/ndn/b", "readvertise");
+  list.insert("/ndn/a/longer");
+  list.insert("/ndn/c");
+
+  auto view = list.getSortedView();
+  BOOST_REQUIRE_EQUAL(view.size(), 3);
+  BOOST_CHECK_EQUAL(view[0]->getName(), "/ndn/a/longer");
+  BOOST_CHECK_EQUAL(view[1]->getName(), "/ndn/b");
+  BOOST_CHECK_EQUAL(view[1]->getCost(), 0);
+  BOOST_CHECK_EQUAL(view[2]->getName(), "/ndn/c");
+
+  // remove() deletes a name of any source
+  BOOST_CHECK_EQUAL(list.remove("/ndn/b"), true);
+  BOOST_CHECK_EQUAL(list.remove("/ndn/b"), false);
+  BOOST_CHECK_EQUAL(list.size(), 2);
+  BOOST_CHECK_EQUAL(list.getSources("/ndn/b").size(), 0);
+}
+
 /*
   Two NamePrefixLists will be considered equal if they contain the
   same names with the same costs. Sources for names are ignored.
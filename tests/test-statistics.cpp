@@ -131,6 +131,9 @@ BOOST_AUTO_TEST_CASE(StatsIncrement)
   BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::SENT_HELLO_INTEREST), 0);
   stats.increment(Statistics::PacketType::SENT_HELLO_INTEREST);
   BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::SENT_HELLO_INTEREST), 1);
+
+  stats.increment(Statistics::PacketType::SIGNED_LSA_SEGMENT, 5);
+  BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::SIGNED_LSA_SEGMENT), 5);
 }
 
 /*
@@ -327,6 +330,27 @@ BOOST_AUTO_TEST_CASE(LsdbReceiveData)
   BOOST_CHECK_EQUAL(collector.getStatistics().get(Statistics::PacketType::RCV_LSA_DATA), 3);
 }
 
+/*
+ * Triggers that arrive while a routing table calculation is scheduled are counted as saved
+ * calculations.
+ */
+BOOST_AUTO_TEST_CASE(RoutingTableCalculation)
+{
+  // Let any pending calculation run
+  this->advanceClocks(ndn::time::seconds(15));
+
+  auto& stats = collector.getStatistics();
+  size_t scheduledBefore = stats.get(Statistics::PacketType::ROUTING_CALC_SCHEDULED);
+  size_t savedBefore = stats.get(Statistics::PacketType::ROUTING_CALC_SAVED);
+
+  nlsr.m_routingTable.scheduleRoutingTableCalculation();
+  nlsr.m_routingTable.scheduleRoutingTableCalculation();
+  nlsr.m_routingTable.scheduleRoutingTableCalculation();
+
+  BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::ROUTING_CALC_SCHEDULED), scheduledBefore + 1);
+  BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::ROUTING_CALC_SAVED), savedBefore + 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -54,7 +54,8 @@ public:
   {
     ndn::Interest interest(prefix.append(parameters.wireEncode()));
     face.receive(interest);
-    this->advanceClocks(ndn::time::milliseconds(10), 10);
+    // Past the Name LSA build interval
+    this->advanceClocks(ndn::time::milliseconds(10), 20);
   }
 
   void sendInterestForPublishedData()
@@ -129,6 +130,29 @@ BOOST_AUTO_TEST_CASE(OnReceiveInterestUnregisterCommand)
   BOOST_CHECK(nameLsaSeqNoBeforeInterest < nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq());
 }
 
+BOOST_AUTO_TEST_CASE(CoalesceNameLsaBuilds)
+{
+  ndn::Name name("/localhost/nlsr/rib/register");
+  face.sentData.clear();
+  for (int i = 0; i < 5; ++i) {
+    ndn::nfd::ControlParameters parameters;
+    parameters.setName(ndn::Name("/test/prefix").appendNumber(i));
+    face.receive(ndn::Interest(ndn::Name(name).append(parameters.wireEncode())));
+  }
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  // Commands are answered at once, the Name LSA is built when the interval has passed
+  BOOST_CHECK_EQUAL(namePrefixes.size(), 5);
+  BOOST_CHECK_EQUAL(face.sentData.size(), 5);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest);
+
+  this->advanceClocks(conf.getNameLsaBuildInterval());
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest + 1);
+  auto nameLsa = nlsr.m_lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+  BOOST_REQUIRE(nameLsa != nullptr);
+  BOOST_CHECK_EQUAL(nameLsa->getNpl(), namePrefixes);
+}
+
 BOOST_AUTO_TEST_CASE(OnReceiveInterestInvalidPrefix)
 {
   ndn::Name name("/localhost/invalid/rib/register");
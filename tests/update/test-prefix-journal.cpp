@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "update/prefix-journal.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace nlsr::tests {
+
+using update::PrefixJournal;
+
+class PrefixJournalFixture
+{
+public:
+  PrefixJournalFixture()
+  {
+    std::filesystem::remove(fileName);
+  }
+
+  ~PrefixJournalFixture()
+  {
+    std::filesystem::remove(fileName);
+  }
+
+  size_t
+  countLines() const
+  {
+    std::ifstream input(fileName);
+    return std::count(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>(), '\n');
+  }
+
+public:
+  const std::string fileName = "/tmp/nlsr-test-prefix.journal";
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestPrefixJournal, PrefixJournalFixture)
+
+BOOST_AUTO_TEST_CASE(AddRemove)
+{
+  PrefixJournal journal(fileName);
+  journal.load();
+  BOOST_CHECK(journal.getPrefixes().empty());
+
+  BOOST_CHECK(journal.add("/prefix/a"));
+  BOOST_CHECK(journal.add("/prefix/b"));
+  BOOST_CHECK(!journal.add("/prefix/a"));
+  BOOST_CHECK(journal.remove("/prefix/a"));
+  BOOST_CHECK(!journal.remove("/prefix/c"));
+
+  BOOST_CHECK(!journal.contains("/prefix/a"));
+  BOOST_CHECK(journal.contains("/prefix/b"));
+  // Each change appends one record, and rejected ones none
+  BOOST_CHECK_EQUAL(journal.getRecordCount(), 3);
+  BOOST_CHECK_EQUAL(countLines(), 3);
+
+  PrefixJournal reloaded(fileName);
+  reloaded.load();
+  BOOST_CHECK_EQUAL(reloaded.getPrefixes().size(), 1);
+  BOOST_CHECK(reloaded.contains("/prefix/b"));
+}
+
+BOOST_AUTO_TEST_CASE(Compaction)
+{
+  PrefixJournal journal(fileName);
+  journal.load();
+  journal.add("/prefix/kept");
+
+  // Saving and deleting the same prefix over and over does not grow the journal without bound
+  for (size_t i = 0; i < 10 * PrefixJournal::COMPACTION_MIN_RECORDS; ++i) {
+    journal.add("/prefix/churn");
+    journal.remove("/prefix/churn");
+  }
+  BOOST_CHECK_LT(journal.getRecordCount(), PrefixJournal::COMPACTION_MIN_RECORDS);
+  BOOST_CHECK_EQUAL(countLines(), journal.getRecordCount());
+
+  journal.compact();
+  BOOST_CHECK_EQUAL(countLines(), 1);
+
+  PrefixJournal reloaded(fileName);
+  reloaded.load();
+  BOOST_CHECK_EQUAL(reloaded.getPrefixes().size(), 1);
+  BOOST_CHECK(reloaded.contains("/prefix/kept"));
+}
+
+BOOST_AUTO_TEST_CASE(MalformedRecords)
+{
+  std::ofstream output(fileName);
+  output << "+ /prefix/a\n"
+         << "garbage\n"
+         << "+ /prefix/b\n"
+         << "- /pre"; // interrupted write
+  output.close();
+
+  PrefixJournal journal(fileName);
+  journal.load();
+  BOOST_CHECK_EQUAL(journal.getPrefixes().size(), 2);
+  BOOST_CHECK(journal.contains("/prefix/a"));
+  BOOST_CHECK(journal.contains("/prefix/b"));
+
+  // The malformed records are dropped, so that new records start on their own line
+  BOOST_CHECK_EQUAL(countLines(), 2);
+  journal.add("/prefix/c");
+
+  PrefixJournal reloaded(fileName);
+  reloaded.load();
+  BOOST_CHECK_EQUAL(reloaded.getPrefixes().size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
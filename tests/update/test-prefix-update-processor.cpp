@@ -20,12 +20,14 @@
  */
 
 #include "update/prefix-update-processor.hpp"
+#include "update/prefix-update-commands.hpp"
 #include "nlsr.hpp"
 
 #include "tests/io-key-chain-fixture.hpp"
 #include "tests/test-common.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/security/interest-signer.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
 
@@ -107,6 +109,18 @@ public:
     this->advanceClocks(ndn::time::milliseconds(100));
   }
 
+  // Bulk commands carry the list in the ApplicationParameters, as nlsrc sends them
+  void
+  sendPrefixListCommand(const ndn::Name& verb, const update::PrefixListParameters& parameters)
+  {
+    ndn::Interest command(ndn::Name("/localhost/nlsr/prefix-update").append(verb));
+    update::PrefixListCommandFormat::encode(command, parameters);
+    ndn::security::InterestSigner signer(m_keyChain);
+    signer.makeSignedInterest(command, ndn::security::signingByIdentity(opIdentity));
+    face.receive(command);
+    this->advanceClocks(ndn::time::milliseconds(10), 20);
+  }
+
   bool
   wasRoutingUpdatePublished()
   {
@@ -169,7 +183,8 @@ BOOST_AUTO_TEST_CASE(Basic)
 
   face.receive(advertiseInterest);
 
-  this->advanceClocks(ndn::time::milliseconds(10));
+  // Past the Name LSA build interval
+  this->advanceClocks(ndn::time::milliseconds(10), 20);
 
   NamePrefixList& namePrefixList = conf.getNamePrefixList();
 
@@ -189,7 +204,7 @@ BOOST_AUTO_TEST_CASE(Basic)
                                                     ndn::security::signingByIdentity(opIdentity));
 
   face.receive(withdrawInterest);
-  this->advanceClocks(ndn::time::milliseconds(10));
+  this->advanceClocks(ndn::time::milliseconds(10), 20);
 
   BOOST_CHECK_EQUAL(namePrefixList.size(), 0);
 
@@ -197,6 +212,108 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK(nameLsaSeqNoBeforeInterest < nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq());
 }
 
+BOOST_AUTO_TEST_CASE(PrefixList)
+{
+  update::PrefixListParameters parameters;
+  parameters.addPrefix("/prefix/to/advertise/1")
+            .addPrefix("/prefix/to/advertise/2", 15)
+            .addPrefix("/prefix/to/advertise/3");
+  BOOST_CHECK_EQUAL(update::PrefixListParameters(parameters.wireEncode()).getPrefixes().size(), 3);
+
+  // Advertise: all prefixes are added by a single Name LSA
+  uint64_t nameLsaSeqNoBeforeInterest = nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq();
+  sendPrefixListCommand("advertise-list", parameters);
+
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 3);
+  BOOST_CHECK_EQUAL(namePrefixList.getPrefixInfoForName("/prefix/to/advertise/2").getCost(), 15);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest + 1);
+  BOOST_CHECK(wasRoutingUpdatePublished());
+
+  // Withdraw a part of the list, including a prefix that is not advertised
+  update::PrefixListParameters withdrawParameters;
+  withdrawParameters.addPrefix("/prefix/to/advertise/1")
+                    .addPrefix("/prefix/to/advertise/2")
+                    .addPrefix("/prefix/not/advertised");
+  nameLsaSeqNoBeforeInterest = nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq();
+  sendPrefixListCommand("withdraw-list", withdrawParameters);
+
+  BOOST_REQUIRE_EQUAL(namePrefixList.size(), 1);
+  BOOST_CHECK_EQUAL(namePrefixList.getNames().front(), "/prefix/to/advertise/3");
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest + 1);
+
+  // An empty list is rejected, and leaves the Name LSA alone
+  nameLsaSeqNoBeforeInterest = nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq();
+  sendPrefixListCommand("withdraw-list", update::PrefixListParameters());
+
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 1);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest);
+
+  // A new cost for an advertised prefix rebuilds the Name LSA
+  update::PrefixListParameters costParameters;
+  costParameters.addPrefix("/prefix/to/advertise/3", 20);
+  sendPrefixListCommand("advertise-list", costParameters);
+
+  BOOST_CHECK_EQUAL(namePrefixList.getPrefixInfoForName("/prefix/to/advertise/3").getCost(), 20);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest + 1);
+
+  // A list that cannot be saved is not applied at all
+  update::PrefixListParameters saveParameters;
+  saveParameters.addPrefix("/prefix/to/save/1")
+                .addPrefix("/prefix/to/save/2")
+                .setFlags(update::PREFIX_FLAG);
+  nameLsaSeqNoBeforeInterest = nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq();
+  sendPrefixListCommand("advertise-list", saveParameters);
+
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 1);
+  BOOST_CHECK(!namePrefixList.contains("/prefix/to/save/1"));
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNoBeforeInterest);
+
+  // The list is still accepted as a name component
+  update::PrefixListParameters nameParameters;
+  nameParameters.addPrefix("/prefix/in/name");
+  ndn::Name command("/localhost/nlsr/prefix-update/advertise-list");
+  command.append(ndn::tlv::GenericNameComponent, nameParameters.wireEncode());
+  ndn::security::InterestSigner signer(m_keyChain);
+  face.receive(signer.makeCommandInterest(command, ndn::security::signingByIdentity(opIdentity)));
+  this->advanceClocks(ndn::time::milliseconds(10), 20);
+
+  BOOST_CHECK(namePrefixList.contains("/prefix/in/name"));
+}
+
+BOOST_AUTO_TEST_CASE(PrefixListChunks)
+{
+  // A long list is sent as several commands, as nlsrc does: hundreds of prefixes fit in each
+  const size_t nPerChunk = 200;
+  std::vector<update::PrefixListParameters> chunks(3);
+  for (size_t i = 0; i < chunks.size() * nPerChunk; ++i) {
+    chunks[i / nPerChunk].addPrefix(ndn::Name("/chunk").appendNumber(i), 10);
+  }
+  // The second chunk fails, as it cannot be saved without a state directory
+  chunks[1].setFlags(update::PREFIX_FLAG);
+
+  auto getResponseCode = [this] {
+    BOOST_REQUIRE(!face.sentData.empty());
+    ndn::nfd::ControlResponse response(face.sentData.back().getContent().blockFromValue());
+    return response.getCode();
+  };
+
+  face.sentData.clear();
+  sendPrefixListCommand("advertise-list", chunks[0]);
+  BOOST_CHECK_EQUAL(getResponseCode(), 200);
+  BOOST_CHECK_EQUAL(namePrefixList.size(), nPerChunk);
+
+  // Each chunk is applied as a whole or not at all, and a failed chunk leaves the earlier ones
+  sendPrefixListCommand("advertise-list", chunks[1]);
+  BOOST_CHECK_EQUAL(getResponseCode(), 500);
+  BOOST_CHECK_EQUAL(namePrefixList.size(), nPerChunk);
+  BOOST_CHECK(namePrefixList.contains(ndn::Name("/chunk").appendNumber(0)));
+  BOOST_CHECK(!namePrefixList.contains(ndn::Name("/chunk").appendNumber(nPerChunk)));
+
+  sendPrefixListCommand("advertise-list", chunks[2]);
+  BOOST_CHECK_EQUAL(getResponseCode(), 200);
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 2 * nPerChunk);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
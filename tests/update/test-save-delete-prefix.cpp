@@ -19,6 +19,8 @@
  * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "update/prefix-journal.hpp"
+#include "update/prefix-update-commands.hpp"
 #include "update/prefix-update-processor.hpp"
 #include "conf-parameter.hpp"
 #include "nlsr.hpp"
@@ -46,6 +48,7 @@ public:
     , siteIdentityName(ndn::Name("/edu/test-site"))
     , opIdentityName(ndn::Name("/edu/test-site").append(ndn::Name("%C1.Operator")))
     , testConfFile("/tmp/nlsr.conf.test")
+    , journalFile(update::makePrefixJournalFileName(testConfFile))
     , conf(face, m_keyChain, testConfFile)
     , confProcessor(conf)
     , nlsr(face, m_keyChain, conf)
@@ -59,6 +62,7 @@ public:
     destination.close();
 
     conf.setConfFileNameDynamic(testConfFile);
+    std::filesystem::remove(journalFile);
     siteIdentity = m_keyChain.createIdentity(siteIdentityName);
     saveIdentityCert(siteIdentity, SITE_CERT_PATH.string());
 
@@ -104,6 +108,11 @@ public:
     face.sentInterests.clear();
   }
 
+  ~PrefixSaveDeleteFixture()
+  {
+    std::filesystem::remove(journalFile);
+  }
+
   uint32_t
   getResponseCode()
   {
@@ -117,18 +126,19 @@ public:
   bool
   checkPrefix(const std::string prefixName)
   {
-    bpt::ptree m_savePrefix;
-    bpt::read_info(testConfFile, m_savePrefix);
+    update::PrefixJournal journal(journalFile);
+    journal.load();
 
-    // counter helps to check if multiple prefix of same name exists on conf file
+    // counter helps to check if multiple records saving the same prefix exist in the journal
     counter = 0;
-    for (const auto& section : m_savePrefix.get_child("advertising")) {
-      auto b = section.second.get_value<std::string>();
-      if (b == prefixName) {
+    std::ifstream input(journalFile);
+    std::string line;
+    while (std::getline(input, line)) {
+      if (line == "+ " + prefixName) {
         counter++;
       }
     }
-    return counter > 0;
+    return journal.contains(prefixName);
   }
 
   ndn::Interest
@@ -153,6 +163,23 @@ public:
     }
   }
 
+  ndn::Interest
+  makePrefixListCommand(std::initializer_list<std::string> prefixNames, const std::string& verb,
+                        bool P_FLAG)
+  {
+    update::PrefixListParameters parameters;
+    for (const auto& prefixName : prefixNames) {
+      parameters.addPrefix(prefixName);
+    }
+    if (P_FLAG) {
+      parameters.setFlags(update::PREFIX_FLAG);
+    }
+    ndn::Name command("/localhost/nlsr/prefix-update");
+    command.append(verb).append(ndn::tlv::GenericNameComponent, parameters.wireEncode());
+    ndn::security::InterestSigner signer(m_keyChain);
+    return signer.makeCommandInterest(command, ndn::security::signingByIdentity(opIdentity));
+  }
+
 public:
   ndn::DummyClientFace face;
   ndn::Name siteIdentityName, routerIdName;
@@ -162,6 +189,7 @@ public:
   ndn::security::pib::Identity opIdentity;
 
   std::string testConfFile;
+  std::string journalFile;
   ConfParameter conf;
   DummyConfFileProcessor confProcessor;
   Nlsr nlsr;
@@ -230,6 +258,38 @@ BOOST_AUTO_TEST_CASE(PrefixStillSavedAfterJustWithdrawn)
   BOOST_CHECK_EQUAL(checkPrefix("/prefix/to/save"), false);
 }
 
+BOOST_AUTO_TEST_CASE(PrefixListOverlap)
+{
+  face.receive(makePrefixListCommand({"/prefix/1", "/prefix/2"}, "advertise-list", true));
+  this->advanceClocks(ndn::time::milliseconds(10));
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK_EQUAL(checkPrefix("/prefix/1"), true);
+  face.sentData.clear();
+
+  // Re-sending an overlapping list, with a name listed twice, saves only the new prefix
+  face.receive(makePrefixListCommand({"/prefix/2", "/prefix/3", "/prefix/3"}, "advertise-list",
+                                     true));
+  this->advanceClocks(ndn::time::milliseconds(10));
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK_EQUAL(checkPrefix("/prefix/2"), true);
+  BOOST_CHECK_EQUAL(counter, 1);
+  BOOST_CHECK_EQUAL(checkPrefix("/prefix/3"), true);
+  BOOST_CHECK_EQUAL(counter, 1);
+  BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 3);
+  face.sentData.clear();
+
+  // Deleting a list that includes an advertised but unsaved prefix
+  face.receive(advertiseWithdraw("/prefix/4", "advertise", false));
+  this->advanceClocks(ndn::time::milliseconds(10));
+  face.sentData.clear();
+  face.receive(makePrefixListCommand({"/prefix/1", "/prefix/4"}, "withdraw-list", true));
+  this->advanceClocks(ndn::time::milliseconds(10));
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK_EQUAL(checkPrefix("/prefix/1"), false);
+  BOOST_CHECK_EQUAL(checkPrefix("/prefix/2"), true);
+  BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utility/timer-wheel.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/io-fixture.hpp"
+
+namespace nlsr::tests {
+
+using util::TimerWheel;
+
+class TimerWheelFixture : public IoFixture
+{
+public:
+  ndn::Scheduler scheduler{m_io};
+  TimerWheel wheel{scheduler};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Schedule)
+{
+  int nFired = 0;
+  auto eventId = wheel.schedule(3_s, [&] { ++nFired; });
+  BOOST_CHECK(eventId);
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  advanceClocks(100_ms, 29);
+  BOOST_CHECK_EQUAL(nFired, 0);
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  BOOST_CHECK(!eventId);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  // Delays are rounded up to the next tick
+  wheel.schedule(1500_ms, [&] { ++nFired; });
+  advanceClocks(100_ms, 15);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(nFired, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  int nFired = 0;
+  auto eventId = wheel.schedule(2_s, [&] { ++nFired; });
+  eventId.cancel();
+  BOOST_CHECK(!eventId);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  {
+    TimerWheel::ScopedEventId scoped = wheel.schedule(2_s, [&] { ++nFired; });
+    BOOST_CHECK(scoped);
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  TimerWheel::ScopedEventId scoped = wheel.schedule(2_s, [&] { ++nFired; });
+  // Reassigning cancels the previous event
+  scoped = wheel.schedule(4_s, [&] { nFired += 10; });
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  advanceClocks(1_s, 3);
+  BOOST_CHECK_EQUAL(nFired, 0);
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(nFired, 10);
+}
+
+BOOST_AUTO_TEST_CASE(CancelReleasesSlot)
+{
+  auto countEntries = [this] {
+    size_t n = 0;
+    for (const auto& level : wheel.m_levels) {
+      for (const auto& slot : level) {
+        n += slot.size();
+      }
+    }
+    return n;
+  };
+
+  std::vector<TimerWheel::EventId> eventIds;
+  for (int i = 1; i <= 100; ++i) {
+    eventIds.push_back(wheel.schedule(ndn::time::seconds(i * 100), [] {}));
+  }
+  BOOST_CHECK_EQUAL(countEntries(), 100);
+
+  // Cancelled events leave their slots immediately, not when the slot comes round
+  for (size_t i = 0; i < eventIds.size(); i += 2) {
+    eventIds[i].cancel();
+  }
+  BOOST_CHECK_EQUAL(countEntries(), 50);
+  BOOST_CHECK_EQUAL(wheel.size(), 50);
+
+  // Events that are moved down to a lower level can still be cancelled
+  advanceClocks(1_s, 250);
+  BOOST_CHECK_EQUAL(countEntries(), 49);
+  eventIds[3].cancel();
+  BOOST_CHECK_EQUAL(countEntries(), 48);
+  BOOST_CHECK_EQUAL(wheel.size(), 48);
+}
+
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  std::vector<int> fired;
+  TimerWheel::EventId second;
+  wheel.schedule(1200_ms, [&] {
+    fired.push_back(1);
+    second.cancel();
+  });
+  second = wheel.schedule(1400_ms, [&] { fired.push_back(2); });
+  wheel.schedule(1600_ms, [&] { fired.push_back(3); });
+
+  // Events of the same tick run together, and one may cancel another
+  advanceClocks(100_ms, 19);
+  BOOST_CHECK(fired.empty());
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired.front(), 1);
+  BOOST_CHECK_EQUAL(fired.back(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(LongDelay)
+{
+  std::vector<int> fired;
+  wheel.schedule(70_s, [&] { fired.push_back(70); });
+  wheel.schedule(5000_s, [&] { fired.push_back(5000); });
+  wheel.schedule(300000_s, [&] { fired.push_back(300000); });
+  BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+  advanceClocks(1_s, 69);
+  BOOST_CHECK(fired.empty());
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+
+  advanceClocks(10_s, 492);
+  advanceClocks(1_s, 9);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  advanceClocks(1_s);
+  BOOST_REQUIRE_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired.back(), 5000);
+
+  // A single large clock advance runs all the ticks in between
+  advanceClocks(300000_s - 5001_s);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  advanceClocks(1_s);
+  BOOST_REQUIRE_EQUAL(fired.size(), 3);
+  BOOST_CHECK_EQUAL(fired.back(), 300000);
+}
+
+BOOST_AUTO_TEST_CASE(Idle)
+{
+  int nFired = 0;
+  wheel.schedule(1_s, [&] { ++nFired; });
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  // No ticks are scheduled while the wheel is empty
+  BOOST_CHECK(!wheel.m_isTicking);
+
+  advanceClocks(1_h);
+  wheel.schedule(2_s, [&] { ++nFired; });
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(nFired, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+
+} // namespace nlsr::tests
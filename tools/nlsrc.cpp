@@ -24,6 +24,7 @@
 #include "config.hpp"
 #include "version.hpp"
 #include "src/publisher/dataset-interest-handler.hpp"
+#include "src/update/prefix-update-commands.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/encoding/block.hpp>
@@ -41,7 +42,9 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace nlsrc {
 
@@ -55,6 +58,11 @@ const uint32_t RESPONSE_CODE_SUCCESS = 200;
 const uint32_t RESPONSE_CODE_NO_EFFECT = 204;
 const uint32_t RESPONSE_CODE_SAVE_OR_DELETE = 205;
 
+// Leaves room in a command Interest for the command name and the signature
+const size_t MAX_PREFIX_LIST_SIZE = ndn::MAX_NDN_PACKET_SIZE - 1000;
+// A chunk of a prefix list failed; the chunk is named on stderr
+const int EXIT_CODE_PREFIX_LIST_CHUNK = 3;
+
 Nlsrc::Nlsrc(std::string programName, ndn::Face& face)
   : m_programName(std::move(programName))
   , m_routerPrefix(LOCALHOST_PREFIX)
@@ -90,6 +98,15 @@ Nlsrc::printUsage() const
            remove a name prefix advertised through NLSR
        withdraw <name> delete
            withdraw and delete the name prefix from the conf file
+       advertise-list [<file> [save]]
+           advertise the name prefixes listed in a file, one "<name> [<cost>]" per line;
+           the list is read from stdin if <file> is omitted or is "-"
+       withdraw-list [<file> [delete]]
+           withdraw the name prefixes listed in a file, or in stdin
+
+   A long prefix list is sent in chunks, one after another. Each chunk is applied as a whole
+   or not at all, but a failed chunk does not undo the chunks before it, and the chunks after
+   it are not sent. The exit status is then 3, and the failing chunk is named on stderr.
 )EOT");
   boost::algorithm::replace_all_copy(std::ostream_iterator<char>(std::cout),
                                      help, "@NLSRC@", m_programName);
@@ -197,6 +214,25 @@ Nlsrc::dispatch(ndn::span<std::string> subcommand)
     return false;
   }
 
+  if (subcommand[0] == "advertise-list" || subcommand[0] == "withdraw-list") {
+    bool isAdvertise = subcommand[0] == "advertise-list";
+    switch (subcommand.size()) {
+      case 1:
+        updatePrefixList("-", ndn::Name::Component(subcommand[0]), false);
+        return true;
+      case 2:
+        updatePrefixList(subcommand[1], ndn::Name::Component(subcommand[0]), false);
+        return true;
+      case 3:
+        if (subcommand[2] != (isAdvertise ? "save" : "delete")) {
+          return false;
+        }
+        updatePrefixList(subcommand[1], ndn::Name::Component(subcommand[0]), true);
+        return true;
+    }
+    return false;
+  }
+
   if (subcommand[0] == "lsdb" || subcommand[0] == "routing" || subcommand[0] == "status") {
     if (subcommand.size() != 1) {
       return false;
@@ -236,6 +272,86 @@ Nlsrc::withdrawName(ndn::Name name, bool wantDelete)
   sendNamePrefixUpdate(name, verb, info, wantDelete);
 }
 
+void
+Nlsrc::updatePrefixList(const std::string& filename, const ndn::Name::Component& verb, bool flag)
+{
+  std::ifstream file;
+  if (filename != "-") {
+    file.open(filename);
+    if (!file.is_open()) {
+      std::cerr << "ERROR: cannot open '" << filename << "'" << std::endl;
+      m_exitCode = 1;
+      return;
+    }
+  }
+  std::istream& input = filename == "-" ? std::cin : file;
+
+  std::vector<nlsr::update::PrefixListParameters> lists(1);
+  size_t listSize = 0;
+  size_t nPrefixes = 0;
+  std::string line;
+  for (size_t lineNo = 1; std::getline(input, line); ++lineNo) {
+    std::istringstream fields(line);
+    std::string uri;
+    if (!(fields >> uri) || uri[0] == ';' || uri[0] == '#') {
+      continue;
+    }
+
+    double cost = 0;
+    std::string extra;
+    if ((!(fields >> cost) && !fields.eof()) || fields >> extra) {
+      std::cerr << "ERROR: invalid cost on line " << lineNo << " of '" << filename << "'"
+                << std::endl;
+      m_exitCode = 1;
+      return;
+    }
+
+    nlsr::PrefixInfo prefix;
+    try {
+      prefix = nlsr::PrefixInfo(ndn::Name(uri), cost);
+    }
+    catch (const std::exception& e) {
+      std::cerr << "ERROR: invalid name on line " << lineNo << " of '" << filename << "': "
+                << e.what() << std::endl;
+      m_exitCode = 1;
+      return;
+    }
+
+    size_t prefixSize = prefix.wireEncode().size();
+    if (listSize > 0 && listSize + prefixSize > MAX_PREFIX_LIST_SIZE) {
+      lists.emplace_back();
+      listSize = 0;
+    }
+    lists.back().addPrefix(prefix.getName(), prefix.getCost());
+    listSize += prefixSize;
+    ++nPrefixes;
+  }
+
+  if (nPrefixes == 0) {
+    std::cerr << "ERROR: no name prefixes in '" << filename << "'" << std::endl;
+    m_exitCode = 1;
+    return;
+  }
+
+  // Commands are sent one after another, and the first failure stops the rest
+  size_t nSent = 0;
+  m_nChunks = lists.size();
+  for (size_t i = 0; i < lists.size(); ++i) {
+    auto& list = lists[i];
+    if (flag) {
+      list.setFlags(1);
+    }
+    nSent += list.getPrefixes().size();
+    std::string info = "(" + verb.toUri() + ": " + std::to_string(nSent) + " of " +
+                       std::to_string(nPrefixes) + " prefixes)";
+    m_fetchSteps.push_back([this, verb, list, info, chunkNo = i + 1] {
+      m_chunkNo = chunkNo;
+      sendPrefixListCommand(verb, list, info);
+    });
+  }
+  runNextStep();
+}
+
 void
 Nlsrc::sendNamePrefixUpdate(const ndn::Name& name,
                             const ndn::Name::Component& verb,
@@ -248,7 +364,14 @@ Nlsrc::sendNamePrefixUpdate(const ndn::Name& name,
     parameters.setFlags(1);
   }
 
-  auto paramWire = parameters.wireEncode();
+  sendPrefixUpdateCommand(verb, parameters.wireEncode(), info);
+}
+
+void
+Nlsrc::sendPrefixUpdateCommand(const ndn::Name::Component& verb,
+                               const ndn::Block& paramWire,
+                               const std::string& info)
+{
   ndn::Name commandName = m_routerPrefix;
   commandName.append(NAME_UPDATE_SUFFIX);
   commandName.append(verb);
@@ -257,6 +380,30 @@ Nlsrc::sendNamePrefixUpdate(const ndn::Name& name,
   ndn::security::InterestSigner signer(m_keyChain);
   auto commandInterest = signer.makeCommandInterest(commandName,
                            ndn::security::signingByIdentity(m_keyChain.getPib().getDefaultIdentity()));
+  expressPrefixUpdateCommand(commandInterest, info);
+}
+
+void
+Nlsrc::sendPrefixListCommand(const ndn::Name::Component& verb,
+                             const nlsr::update::PrefixListParameters& list,
+                             const std::string& info)
+{
+  ndn::Name commandName = m_routerPrefix;
+  commandName.append(NAME_UPDATE_SUFFIX);
+  commandName.append(verb);
+
+  // The list goes in the ApplicationParameters, which are covered by the signature
+  ndn::Interest commandInterest(commandName);
+  nlsr::update::PrefixListCommandFormat::encode(commandInterest, list);
+  ndn::security::InterestSigner signer(m_keyChain);
+  signer.makeSignedInterest(commandInterest,
+                            ndn::security::signingByIdentity(m_keyChain.getPib().getDefaultIdentity()));
+  expressPrefixUpdateCommand(commandInterest, info);
+}
+
+void
+Nlsrc::expressPrefixUpdateCommand(ndn::Interest& commandInterest, const std::string& info)
+{
   commandInterest.setMustBeFresh(true);
 
   m_face.expressInterest(commandInterest,
@@ -270,6 +417,7 @@ Nlsrc::onControlResponse(const std::string& info, const ndn::Data& data)
 {
   if (data.getMetaInfo().getType() == ndn::tlv::ContentType_Nack) {
     std::cerr << "ERROR: Run-time advertise/withdraw disabled" << std::endl;
+    m_exitCode = getFailureExitCode();
     return;
   }
 
@@ -280,21 +428,44 @@ Nlsrc::onControlResponse(const std::string& info, const ndn::Data& data)
   }
   catch (const std::exception& e) {
     std::cerr << "ERROR: Control response decoding error" << std::endl;
-    m_exitCode = 1;
+    m_exitCode = getFailureExitCode();
     return;
   }
 
   uint32_t code = response.getCode();
 
+  if (code == RESPONSE_CODE_NO_EFFECT) {
+    std::cout << response.getText() << " " << info << std::endl;
+    m_exitCode = 0;
+    runNextStep();
+    return;
+  }
+
   if (code != RESPONSE_CODE_SUCCESS && code != RESPONSE_CODE_SAVE_OR_DELETE) {
     std::cerr << response.getText() << std::endl;
     std::cerr << "Name prefix update error (code: " << code << ")" << std::endl;
-    m_exitCode = code == RESPONSE_CODE_NO_EFFECT ? 0 : 1;
+    m_exitCode = getFailureExitCode();
     return;
   }
 
   std::cout << "Applied Name prefix update successfully: " << info << std::endl;
   m_exitCode = 0;
+  runNextStep();
+}
+
+int
+Nlsrc::getFailureExitCode() const
+{
+  if (m_chunkNo == 0) {
+    return 1;
+  }
+
+  std::cerr << "ERROR: chunk " << m_chunkNo << " of " << m_nChunks << " of the prefix list failed";
+  if (m_chunkNo > 1) {
+    std::cerr << "; chunks 1 to " << m_chunkNo - 1 << " remain applied";
+  }
+  std::cerr << std::endl;
+  return EXIT_CODE_PREFIX_LIST_CHUNK;
 }
 
 void
@@ -397,7 +568,7 @@ Nlsrc::onTimeout(uint32_t errorCode, const std::string& error)
 {
   std::cerr << "Request timed out (code: " << errorCode
             << ", error: " << error << ")"  << std::endl;
-  m_exitCode = 1;
+  m_exitCode = getFailureExitCode();
 }
 
 void
@@ -36,6 +36,10 @@
 #ifndef NLSR_TOOLS_NLSRC_HPP
 #define NLSR_TOOLS_NLSRC_HPP
 
+namespace nlsr::update {
+class PrefixListParameters;
+} // namespace nlsr::update
+
 namespace nlsrc {
 
 class Nlsrc : boost::noncopyable
@@ -98,15 +102,46 @@ private:
   void
   withdrawName(ndn::Name name, bool wantDelete);
 
+  /**
+   * \brief Advertises or withdraws the name prefixes listed in a file
+   *
+   * file format, one prefix per line:
+   *   name [cost]
+   *
+   * Empty lines and lines starting with ';' or '#' are ignored. The list is sent in as few
+   * commands as the maximum packet size allows; each command is applied by NLSR as a whole.
+   */
+  void
+  updatePrefixList(const std::string& filename, const ndn::Name::Component& verb, bool flag);
+
   void
   sendNamePrefixUpdate(const ndn::Name& name,
                        const ndn::Name::Component& verb,
                        const std::string& info,
                        bool saveFlag);
 
+  void
+  sendPrefixUpdateCommand(const ndn::Name::Component& verb,
+                          const ndn::Block& parameters,
+                          const std::string& info);
+
+  void
+  sendPrefixListCommand(const ndn::Name::Component& verb,
+                        const nlsr::update::PrefixListParameters& list,
+                        const std::string& info);
+
+  void
+  expressPrefixUpdateCommand(ndn::Interest& commandInterest, const std::string& info);
+
   void
   onControlResponse(const std::string& info, const ndn::Data& data);
 
+  /*! \brief Reports which chunk of a prefix list failed, if any.
+   *  \return the exit code of the failure: 3 for a chunk of a prefix list, 1 otherwise.
+   */
+  int
+  getFailureExitCode() const;
+
 private:
   void
   fetchAdjacencyLsas();
@@ -168,6 +203,9 @@ private:
   std::map<ndn::Name, Router> m_routers;
   std::string m_rtString;
   std::deque<std::function<void()>> m_fetchSteps;
+  // The chunk of a prefix list in flight, numbered from 1; 0 outside of a list
+  size_t m_chunkNo = 0;
+  size_t m_nChunks = 0;
 
   int m_exitCode = 0;
 };